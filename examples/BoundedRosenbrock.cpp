@@ -0,0 +1,85 @@
+#include <iostream>
+
+#include <Optimization/LBFGSB.hpp>
+#include <Optimization/SpectralProjectedGradient.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  The extended Rosenbrock function of the first driver of L-BFGS-B,
+ *
+ *      f(x) = 0.25 (x_1 - 1)^2 + sum_{i=2}^n 4 (x_i - x_{i-1}^2)^2,
+ *
+ *  with the bounds 1 <= x_i <= 100 for odd i and -100 <= x_i <= 100 for even i.
+ *
+ *  Ciyou Zhu, Richard H. Byrd, Peihuang Lu, Jorge Nocedal (1997). Algorithm 778: L-BFGS-B:
+ *  Fortran subroutines for large-scale bound-constrained optimization.
+ *  ACM Transactions on Mathematical Software (TOMS), 23(4), 550-560.
+ */
+
+
+const int n = 25;
+
+void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+{
+    funcValue = 0.25 * std::pow(parameters(0) - 1, 2);
+    for (int i = 1; i < n; i++)
+    {
+        funcValue += 4 * std::pow(parameters(i) - std::pow(parameters(i - 1), 2), 2);
+    }
+
+    return;
+}
+
+void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
+{
+    double residual = parameters(1) - std::pow(parameters(0), 2);
+
+    gradient(0) = 0.5 * (parameters(0) - 1) - 16 * parameters(0) * residual;
+    for (int i = 1; i < n - 1; i++)
+    {
+        const double lastResidual = residual;
+
+        residual = parameters(i + 1) - std::pow(parameters(i), 2);
+        gradient(i) = 8 * lastResidual - 16 * parameters(i) * residual;
+    }
+    gradient(n - 1) = 8 * residual;
+
+    return;
+}
+
+int main()
+{
+    Function<> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Function<> objFuncInfoApproxDerivative(objFunc);
+    Eigen::VectorXd initialParameters = Eigen::VectorXd::Constant(n, 3.0);
+    Eigen::VectorXd lowerBounds(n);
+    Eigen::VectorXd upperBounds = Eigen::VectorXd::Constant(n, 100.0);
+    Result result;
+
+    for (int i = 0; i < n; i++)
+    {
+        lowerBounds(i) = (i % 2 == 0) ? 1.0 : -100.0;
+    }
+
+    // L-BFGS-B, Exact Derivative
+    LBFGSB<>(objFuncInfoExactDerivative, lowerBounds, upperBounds, initialParameters).solve(result);
+    std::cout << "------------------------------ L-BFGS-B, Exact Derivative ------------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // L-BFGS-B, Approximate Derivative
+    LBFGSB<>(objFuncInfoApproxDerivative, lowerBounds, upperBounds, initialParameters).solve(result);
+    std::cout << "--------------------------- L-BFGS-B, Approximate Derivative ---------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Spectral Projected Gradient, Exact Derivative
+    SpectralProjectedGradient<> spg(objFuncInfoExactDerivative, initialParameters);
+    spg.setBounds(lowerBounds, upperBounds);
+    spg.solve(result);
+    std::cout << "-------------------- Spectral Projected Gradient, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    return 0;
+}
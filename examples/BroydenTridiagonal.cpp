@@ -0,0 +1,138 @@
+#include <iostream>
+#include <vector>
+
+#include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/BFGS.hpp>
+#include <Optimization/LBFGS.hpp>
+#include <Optimization/SparseNewton.hpp>
+#include <Optimization/SpectralProjectedGradient.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  See item (30) in Section 3 of the following paper for the definition of Broyden tridiagonal function.
+ *
+ *  Moré, J. J., Garbow, B. S., Hillstrom, K. E. (1981). Testing unconstrained optimization software.
+ *  ACM Transactions on Mathematical Software (TOMS), 7(1), 17-41.
+ *
+ *  Each part depends on three neighbouring parameters, hence the Hessian is pentadiagonal.
+ */
+
+
+const int n = 20;
+const int m = n;
+
+void objFuncPart(const Eigen::VectorXd & parameters, Eigen::VectorXd & objFuncPartValue)
+{
+    for (int i = 0; i < m; i++)
+    {
+        const double previous = (i > 0) ? parameters(i - 1) : 0.0;
+        const double next = (i < n - 1) ? parameters(i + 1) : 0.0;
+
+        objFuncPartValue(i) = (3 - 2 * parameters(i)) * parameters(i) - previous - 2 * next + 1;
+    }
+
+    return;
+}
+
+void gradFuncPart(const Eigen::VectorXd & parameters, Eigen::SparseMatrix<double> & gradFuncPartValue)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+
+    for (int i = 0; i < m; i++)
+    {
+        if (i > 0)
+        {
+            triplets.emplace_back(i, i - 1, -1.0);
+        }
+        triplets.emplace_back(i, i, 3 - 4 * parameters(i));
+        if (i < n - 1)
+        {
+            triplets.emplace_back(i, i + 1, -2.0);
+        }
+    }
+
+    gradFuncPartValue.resize(m, n);
+    gradFuncPartValue.setFromTriplets(triplets.begin(), triplets.end());
+
+    return;
+}
+
+void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+{
+    Eigen::VectorXd objFuncPartValue(m);
+
+    objFuncPart(parameters, objFuncPartValue);
+    funcValue = objFuncPartValue.squaredNorm();
+
+    return;
+}
+
+void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
+{
+    Eigen::VectorXd objFuncPartValue(m);
+    Eigen::SparseMatrix<double> gradFuncPartValue;
+
+    objFuncPart(parameters, objFuncPartValue);
+    gradFuncPart(parameters, gradFuncPartValue);
+
+    gradient = 2 * gradFuncPartValue.transpose() * objFuncPartValue;
+
+    return;
+}
+
+void hessFunc(const Eigen::VectorXd & parameters, Eigen::SparseMatrix<double> & hessian)
+{
+    Eigen::VectorXd objFuncPartValue(m);
+    Eigen::SparseMatrix<double> gradFuncPartValue;
+
+    objFuncPart(parameters, objFuncPartValue);
+    gradFuncPart(parameters, gradFuncPartValue);
+
+    // The Hessian of the i-th part is -4 at (i, i). The pattern of the product is the same in
+    // every call, as required by SparseNewton.
+    hessian = 2 * Eigen::SparseMatrix<double>(gradFuncPartValue.transpose() * gradFuncPartValue);
+    hessian.diagonal() -= 8 * objFuncPartValue;
+
+    return;
+}
+
+int main()
+{
+    std::shared_ptr<BaseAlgorithm<>> algorithm;
+    Function<> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Eigen::VectorXd initialParameters = Eigen::VectorXd::Constant(n, -1.0);
+    Result result;
+
+    // BFGS, Nocedal Line Search, Exact Derivative
+    BFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "------------------- BFGS, Nocedal Line Search, Exact Derivative ------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // L-BFGS, Nocedal Line Search, Exact Derivative
+    LBFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "-------------------- L-BFGS, Nocedal Line Search, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Spectral Projected Gradient, Exact Derivative
+    SpectralProjectedGradient<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "-------------------- Spectral Projected Gradient, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Sparse Newton, Nocedal Line Search, Exact Hessian
+    SparseNewton<>(objFuncInfoExactDerivative, hessFunc, initialParameters).solve(result);
+    std::cout << "--------------- Sparse Newton, Nocedal Line Search, Exact Hessian ----------------------" << std::endl;
+    std::cout << result << std::endl;
+    std::cout << "Number of Hessian evaluations: " << objFuncInfoExactDerivative.getNumHessEvaluations() << std::endl << std::endl;
+
+    // Sparse Newton, Backtracking Line Search, Exact Hessian
+    algorithm = std::make_shared<SparseNewton<>>(objFuncInfoExactDerivative, hessFunc, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
+    algorithm->solve(result);
+    std::cout << "------------ Sparse Newton, Backtracking Line Search, Exact Hessian --------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    return 0;
+}
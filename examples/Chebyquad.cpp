@@ -1,7 +1,11 @@
 #include <iostream>
 
 #include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchBrent.hpp>
 #include <Optimization/BFGS.hpp>
+#include <Optimization/LBFGS.hpp>
+#include <Optimization/SR1.hpp>
+#include <Optimization/SpectralProjectedGradient.hpp>
 #include <Optimization/SteepestDescent.hpp>
 
 
@@ -152,9 +156,9 @@ void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
 
 int main()
 {
-    std::shared_ptr<BaseAlgorithm> algorithm;
-    Function objFuncInfoExactDerivative(objFunc, gradFunc);
-    Function objFuncInfoApproxDerivative(objFunc);
+    std::shared_ptr<BaseAlgorithm<>> algorithm;
+    Function<> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Function<> objFuncInfoApproxDerivative(objFunc);
     Eigen::VectorXd initialParameters(n);
     for (int j = 0; j < n; j++)
     {
@@ -163,52 +167,81 @@ int main()
     Result result;
 
     // Steepest Descent, Nocedal Line Search, Exact Derivative
-    SteepestDescent(objFuncInfoExactDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------- Steepest Descent, Nocedal Line Search, Exact Derivative ------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Nocedal Line Search, Exact Derivative
-    BFGS(objFuncInfoExactDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------------- BFGS, Nocedal Line Search, Exact Derivative ------------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // Steepest Descent, Nocedal Line Search, Approximate Derivative
-    SteepestDescent(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------- Steepest Descent, Nocedal Line Search, Approximate Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // BFGS, Nocedal Line Search, Approximate Derivative
-    BFGS(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------------- BFGS, Nocedal Line Search, Approximate Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // L-BFGS, Nocedal Line Search, Exact Derivative
+    LBFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "-------------------- L-BFGS, Nocedal Line Search, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     // Steepest Descent, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------ Steepest Descent, Backtracking Line Search, Exact Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------------ BFGS, Backtracking Line Search, Exact Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------- Steepest Descent, Backtracking Line Search, Approximate Derivative -----------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------------- BFGS, Backtracking Line Search, Approximate Derivative -----------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // Steepest Descent, Brent Line Search, Approximate Derivative
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBrent<>>(objFuncInfoApproxDerivative));
+    algorithm->solve(result);
+    std::cout << "------------ Steepest Descent, Brent Line Search, Approximate Derivative ---------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // BFGS, Brent Line Search, Approximate Derivative
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBrent<>>(objFuncInfoApproxDerivative));
+    algorithm->solve(result);
+    std::cout << "------------------ BFGS, Brent Line Search, Approximate Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Spectral Projected Gradient, Exact Derivative
+    SpectralProjectedGradient<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "-------------------- Spectral Projected Gradient, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // SR1, Trust Region, Exact Derivative
+    SR1<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "------------------------- SR1, Trust Region, Exact Derivative --------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     return 0;
 }
@@ -0,0 +1,99 @@
+#include <iostream>
+
+#include <Optimization/CompositeFunction.hpp>
+#include <Optimization/FISTA.hpp>
+#include <Optimization/OWLQN.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  L1-regularized linear least squares (LASSO),
+ *
+ *      F(x) = 0.5 ||A x - b||^2 + lambda ||x||_1,
+ *
+ *  with an underdetermined m x n matrix A, m < n, and b = A x* for a sparse x*. The smooth
+ *  part is minimized by FISTA with the soft thresholding of L1Norm as proximal operator,
+ *  and, for comparison, subject to 0 <= x <= 1 with the projection of BoxIndicator. OWLQN
+ *  minimizes F with limited-memory quasi-Newton steps instead.
+ *
+ *  Robert Tibshirani (1996). Regression Shrinkage and Selection via the Lasso.
+ *  Journal of the Royal Statistical Society, Series B, 58(1), 267-288.
+ */
+
+
+const int m = 50;
+const int n = 100;
+const double lambda = 0.1;
+
+Eigen::MatrixXd A;
+Eigen::VectorXd b;
+
+void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+{
+    funcValue = 0.5 * (A * parameters - b).squaredNorm();
+
+    return;
+}
+
+void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
+{
+    gradient.noalias() = A.transpose() * (A * parameters - b);
+
+    return;
+}
+
+int main()
+{
+    A.resize(m, n);
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            A(i, j) = std::sin((i + 1.0) * (j + 1.0)) / std::sqrt(m);
+        }
+    }
+
+    Eigen::VectorXd sparseParameters = Eigen::VectorXd::Zero(n);
+    sparseParameters(3) = 1.0;
+    sparseParameters(17) = 0.5;
+    sparseParameters(42) = 0.8;
+    sparseParameters(77) = 0.3;
+    b = A * sparseParameters;
+
+    Function<> smoothFunc(objFunc, gradFunc);
+    Eigen::VectorXd initialParameters = Eigen::VectorXd::Zero(n);
+    Eigen::VectorXd lowerBounds = Eigen::VectorXd::Zero(n);
+    Eigen::VectorXd upperBounds = Eigen::VectorXd::Ones(n);
+    Result result;
+
+    // FISTA, L1 Norm
+    CompositeFunction<> lassoFunc(smoothFunc, L1Norm<>(lambda), L1Norm<>(lambda));
+    FISTA<> fista(lassoFunc, initialParameters);
+    fista.solve(result);
+    std::cout << "------------------------------------ FISTA, L1 Norm ------------------------------------" << std::endl;
+    std::cout << result << std::endl;
+    std::cout << "Number of restarts: " << fista.getNumRestarts() << std::endl;
+    std::cout << "Number of nonzero parameters: " << (result.getOptParameters().array() != 0.0).count() << std::endl << std::endl;
+
+    // FISTA without restart, L1 Norm
+    fista.setRestart(false);
+    fista.solve(result);
+    std::cout << "---------------------------- FISTA without Restart, L1 Norm ----------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // OWL-QN
+    OWLQN<>(smoothFunc, lambda, initialParameters).solve(result);
+    std::cout << "---------------------------------------- OWL-QN ----------------------------------------" << std::endl;
+    std::cout << result << std::endl;
+    std::cout << "Number of nonzero parameters: " << (result.getOptParameters().array() != 0.0).count() << std::endl << std::endl;
+
+    // FISTA, Box Indicator
+    CompositeFunction<> boxFunc(smoothFunc, BoxIndicator<>(lowerBounds, upperBounds), BoxIndicator<>(lowerBounds, upperBounds));
+    FISTA<>(boxFunc, initialParameters).solve(result);
+    std::cout << "--------------------------------- FISTA, Box Indicator ---------------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    return 0;
+}
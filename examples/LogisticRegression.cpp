@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <iostream>
+
+#include <Optimization/AdaGrad.hpp>
+#include <Optimization/Adam.hpp>
+#include <Optimization/StochasticGradientDescent.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  L2-regularized logistic regression over N samples (a_i, b_i) with labels b_i in {0, 1},
+ *
+ *      F(x) = 1 / N sum_{i=0}^{N-1} log(1 + exp(a_i^T x)) - b_i a_i^T x + 0.5 mu ||x||^2,
+ *
+ *  whose sum over a sample range is evaluated by the callables of a StochasticFunction. The
+ *  features are uniform in [-1, 1] from a linear congruential generator, and the labels are
+ *  drawn from the model of a fixed parameter vector.
+ */
+
+
+const int numSamples = 10000;
+const int n = 20;
+const double mu = 1e-3;
+
+Eigen::MatrixXd features;
+Eigen::VectorXd labels;
+
+double uniform(std::uint64_t & state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    return static_cast<double>(state >> 11) / 9007199254740992.0;
+}
+
+void objFunc(const Eigen::VectorXd & parameters, Eigen::Index first, Eigen::Index last, double & funcValue)
+{
+    funcValue = 0.0;
+    for (Eigen::Index i = first; i < last; i++)
+    {
+        const double margin = features.col(i).dot(parameters);
+
+        funcValue += std::max(margin, 0.0) + std::log1p(std::exp(-std::fabs(margin))) - labels(i) * margin;
+    }
+    funcValue += 0.5 * mu * (last - first) * parameters.squaredNorm();
+
+    return;
+}
+
+void gradFunc(const Eigen::VectorXd & parameters, Eigen::Index first, Eigen::Index last, Eigen::VectorXd & gradient)
+{
+    gradient = mu * (last - first) * parameters;
+    for (Eigen::Index i = first; i < last; i++)
+    {
+        const double margin = features.col(i).dot(parameters);
+
+        gradient += (1.0 / (1.0 + std::exp(-margin)) - labels(i)) * features.col(i);
+    }
+
+    return;
+}
+
+void printCheckpoints(const std::vector<Checkpoint> & checkpoints)
+{
+    std::cout << "Epoch   Function value   Gradient norm" << std::endl;
+    for (const Checkpoint & checkpoint : checkpoints)
+    {
+        std::cout << checkpoint.numEpochs << "   " << checkpoint.funcValue << "   " << checkpoint.gradNorm << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::uint64_t state = 42;
+    Eigen::VectorXd trueParameters(n);
+    for (int j = 0; j < n; j++)
+    {
+        trueParameters(j) = 4.0 * uniform(state) - 2.0;
+    }
+
+    // One column per sample, so a batch is a contiguous block of memory.
+    features.resize(n, numSamples);
+    labels.resize(numSamples);
+    for (int i = 0; i < numSamples; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            features(j, i) = 2.0 * uniform(state) - 1.0;
+        }
+
+        const double probability = 1.0 / (1.0 + std::exp(-features.col(i).dot(trueParameters)));
+        labels(i) = (uniform(state) < probability) ? 1.0 : 0.0;
+    }
+
+    StochasticFunction<> objFuncInfo(numSamples, objFunc, gradFunc);
+    Eigen::VectorXd initialParameters = Eigen::VectorXd::Zero(n);
+    Result result;
+
+    // SGD with Momentum
+    StochasticGradientDescent<> sgd(objFuncInfo, initialParameters, 1e-4, 1e-9, 20, InverseTimeLearningRate(0.05, 1e-3));
+    sgd.setCheckpointInterval(5);
+    sgd.solve(result);
+    std::cout << "---------------------------------- SGD with Momentum -----------------------------------" << std::endl;
+    std::cout << result << std::endl;
+    printCheckpoints(sgd.getCheckpoints());
+
+    // Adam
+    Adam<> adam(objFuncInfo, initialParameters, 1e-4, 1e-9, 20, ConstantLearningRate(0.01));
+    adam.setCheckpointInterval(5);
+    adam.solve(result);
+    std::cout << "----------------------------------------- Adam -----------------------------------------" << std::endl;
+    std::cout << result << std::endl;
+    printCheckpoints(adam.getCheckpoints());
+
+    // AdaGrad
+    AdaGrad<> adaGrad(objFuncInfo, initialParameters, 1e-4, 1e-9, 20, StepLearningRate(0.5, 0.5, 2000));
+    adaGrad.setBatchSize(64);
+    adaGrad.setCheckpointInterval(5);
+    adaGrad.solve(result);
+    std::cout << "--------------------------------------- AdaGrad ----------------------------------------" << std::endl;
+    std::cout << result << std::endl;
+    printCheckpoints(adaGrad.getCheckpoints());
+
+    return 0;
+}
@@ -1,90 +1,157 @@
 #include <iostream>
 
 #include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchInterpolation.hpp>
 #include <Optimization/BFGS.hpp>
+#include <Optimization/ConjugateGradient.hpp>
 #include <Optimization/SteepestDescent.hpp>
 
 
 using namespace Optimization;
 
-const int n = 10;
+/* 
+ *  The problem data is held by the functor instead of global variables, hence several
+ *  differently parameterized quadratics can be solved side by side.
+ */
 
-void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+struct Quadratic
 {
-    funcValue = 0;
-    for (int i = 0; i < n; i++)
+    int n;
+
+    void operator()(const Eigen::VectorXd & parameters, double & funcValue) const
     {
-        funcValue += (i + 1) * std::pow(parameters(i) - i, 2);
+        funcValue = 0;
+        for (int i = 0; i < n; i++)
+        {
+            funcValue += (i + 1) * std::pow(parameters(i) - i, 2);
+        }
+
+        return;
     }
 
-    return;
-}
+    void operator()(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient) const
+    {   
+        for (int i = 0; i < n; i++)
+        {
+            gradient(i) = 2 * (i + 1) * (parameters(i) - i);
+        }
 
-void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
-{   
-    for (int i = 0; i < n; i++)
-    {
-        gradient(i) = 2 * (i + 1) * (parameters(i) - i);
+        return;
     }
 
-    return;
-}
+    // Evaluates all columns of points in one call.
+    void operator()(const Eigen::MatrixXd & points, Eigen::VectorXd & funcValues) const
+    {
+        funcValues.setZero();
+        for (int i = 0; i < n; i++)
+        {
+            for (Eigen::Index j = 0; j < points.cols(); j++)
+            {
+                funcValues(j) += (i + 1) * std::pow(points(i, j) - i, 2);
+            }
+        }
+
+        return;
+    }
+};
 
 int main()
 {
-    std::shared_ptr<BaseAlgorithm> algorithm;
-    Function objFuncInfoExactDerivative(objFunc, gradFunc);
-    Function objFuncInfoApproxDerivative(objFunc);
+    const int n = 10;
+    const Quadratic quadratic{n};
+
+    std::shared_ptr<BaseAlgorithm<>> algorithm;
+    Function<> objFuncInfoExactDerivative(quadratic, quadratic);
+    Function<> objFuncInfoApproxDerivative(quadratic, nullptr, quadratic);
     Eigen::VectorXd initialParameters = Eigen::VectorXd::Constant(n, n);
     Result result;
 
     // Steepest Descent, Nocedal Line Search, Exact Derivative
-    SteepestDescent(objFuncInfoExactDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------- Steepest Descent, Nocedal Line Search, Exact Derivative ------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Nocedal Line Search, Exact Derivative
-    BFGS(objFuncInfoExactDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------------- BFGS, Nocedal Line Search, Exact Derivative ------------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // Steepest Descent, Nocedal Line Search, Approximate Derivative
-    SteepestDescent(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------- Steepest Descent, Nocedal Line Search, Approximate Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // BFGS, Nocedal Line Search, Approximate Derivative
-    BFGS(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------------- BFGS, Nocedal Line Search, Approximate Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------ Steepest Descent, Backtracking Line Search, Exact Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------------ BFGS, Backtracking Line Search, Exact Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------- Steepest Descent, Backtracking Line Search, Approximate Derivative -----------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------------- BFGS, Backtracking Line Search, Approximate Derivative -----------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // Steepest Descent, Interpolating Line Search, Exact Derivative
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchInterpolation<>>(objFuncInfoExactDerivative));
+    algorithm->solve(result);
+    std::cout << "----------- Steepest Descent, Interpolating Line Search, Exact Derivative --------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // BFGS, Interpolating Line Search, Exact Derivative
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchInterpolation<>>(objFuncInfoExactDerivative));
+    algorithm->solve(result);
+    std::cout << "----------------- BFGS, Interpolating Line Search, Exact Derivative --------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // The same quadratic given by its matrix, linear term and constant. The solvers minimize it
+    // exactly along each direction.
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(n, n);
+    Eigen::VectorXd linearTerm(n);
+    double constant = 0;
+    for (int i = 0; i < n; i++)
+    {
+        matrix(i, i) = 2 * (i + 1);
+        linearTerm(i) = 2 * (i + 1) * i;
+        constant += (i + 1) * i * i;
+    }
+
+    QuadraticFunction<> denseQuadratic(matrix, linearTerm, constant);
+    QuadraticFunction<> sparseQuadratic(QuadraticFunction<>::SparseMatrix(matrix.sparseView()), linearTerm, constant);
+
+    // Conjugate Gradient, Exact Line Search, Dense Matrix
+    ConjugateGradient<>(denseQuadratic, initialParameters).solve(result);
+    std::cout << "------------- Conjugate Gradient, Exact Line Search, Dense Matrix ----------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Conjugate Gradient, Exact Line Search, Sparse Matrix
+    ConjugateGradient<>(sparseQuadratic, initialParameters).solve(result);
+    std::cout << "------------- Conjugate Gradient, Exact Line Search, Sparse Matrix ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     return 0;
 }
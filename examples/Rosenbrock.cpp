@@ -1,22 +1,25 @@
 #include <iostream>
 
+#include <Optimization/LineSearchAdaptive.hpp>
 #include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchParallel.hpp>
 #include <Optimization/BFGS.hpp>
 #include <Optimization/SteepestDescent.hpp>
+#include <Optimization/StaticSolver.hpp>
 
 
 using namespace Optimization;
 
 
-void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+void objFunc(const Eigen::Vector2d & parameters, double & funcValue)
 {
     funcValue = 100 * std::pow(parameters(1) - std::pow(parameters(0), 2), 2) + std::pow(1 - parameters(0), 2);
 
     return;
 }
 
-void gradFunc(const Eigen::VectorXd & parameters,
-              Eigen::VectorXd & gradient)
+void gradFunc(const Eigen::Vector2d & parameters,
+              Eigen::Vector2d & gradient)
 {   
     gradient(0) = -400 * (parameters(1) - std::pow(parameters(0), 2.0)) * parameters(0) - 2 * (1 - parameters(0));
     gradient(1) = 200 * (parameters(1) - std::pow(parameters(0), 2.0));
@@ -26,59 +29,97 @@ void gradFunc(const Eigen::VectorXd & parameters,
 
 int main()
 {
-    std::shared_ptr<BaseAlgorithm> algorithm;
-    Function objFuncInfoExactDerivative(objFunc, gradFunc);
-    Function objFuncInfoApproxDerivative(objFunc);
+    std::shared_ptr<BaseAlgorithm<2>> algorithm;
+    Function<2> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Function<2> objFuncInfoApproxDerivative(objFunc);
     Eigen::Vector2d initialParameters(-5, 10);
     Result result;
 
     // Steepest Descent, Nocedal Line Search, Exact Derivative
-    SteepestDescent(objFuncInfoExactDerivative, initialParameters).solve(result);
+    SteepestDescent<2>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------- Steepest Descent, Nocedal Line Search, Exact Derivative ------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Nocedal Line Search, Exact Derivative
-    BFGS(objFuncInfoExactDerivative, initialParameters).solve(result);
+    BFGS<2>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------------- BFGS, Nocedal Line Search, Exact Derivative ------------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // Steepest Descent, Nocedal Line Search, Approximate Derivative
-    SteepestDescent(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    SteepestDescent<2>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------- Steepest Descent, Nocedal Line Search, Approximate Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // BFGS, Nocedal Line Search, Approximate Derivative
-    BFGS(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    BFGS<2>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------------- BFGS, Nocedal Line Search, Approximate Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // BFGS, Nocedal Line Search, Approximate Derivative, Scaling
+    BFGS<2> scaledBFGS(objFuncInfoApproxDerivative, initialParameters);
+    scaledBFGS.setScaling(true);
+    scaledBFGS.solve(result);
+    std::cout << "-------------- BFGS, Nocedal Line Search, Approximate Derivative, Scaling --------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     // Steepest Descent, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<SteepestDescent<2>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<2>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------ Steepest Descent, Backtracking Line Search, Exact Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<BFGS<2>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<2>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------------ BFGS, Backtracking Line Search, Exact Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<SteepestDescent<2>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<2>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------- Steepest Descent, Backtracking Line Search, Approximate Derivative -----------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<BFGS<2>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<2>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------------- BFGS, Backtracking Line Search, Approximate Derivative -----------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // Steepest Descent, Backtracking Line Search, Exact Derivative, Barzilai-Borwein Initial Step
+    algorithm = std::make_shared<SteepestDescent<2>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<2>>(objFuncInfoExactDerivative));
+    algorithm->setInitialStep(std::make_shared<InitialStepBarzilaiBorwein<2>>());
+    algorithm->solve(result);
+    std::cout << "------- Steepest Descent, Backtracking, Exact Derivative, Barzilai-Borwein Step --------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // BFGS, Parallel Line Search, Exact Derivative, Four Threads
+    algorithm = std::make_shared<BFGS<2>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchParallel<2>>(objFuncInfoExactDerivative, std::make_shared<ThreadPool>(4)));
+    algorithm->solve(result);
+    std::cout << "-------------- BFGS, Parallel Line Search, Exact Derivative, Four Threads --------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Steepest Descent, Adaptive Line Search, Approximate Derivative
+    algorithm = std::make_shared<SteepestDescent<2>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchAdaptive<2>>(objFuncInfoApproxDerivative));
+    algorithm->solve(result);
+    std::cout << "------------ Steepest Descent, Adaptive Line Search, Approximate Derivative ------------" << std::endl;
+    std::cout << result << std::endl;
+    std::cout << "Cost measurement after the solve: " << (objFuncInfoApproxDerivative.getMeasureCost() ? "on" : "off") << std::endl << std::endl;
+
+    // BFGS, Nocedal Line Search, Exact Derivative, Static Dispatch
+    auto objFuncInfoStatic = makeFunction<2>([](const Eigen::Vector2d & parameters, double & funcValue) { objFunc(parameters, funcValue); },
+                                             [](const Eigen::Vector2d & parameters, Eigen::Vector2d & gradient) { gradFunc(parameters, gradient); });
+    typedef decltype(objFuncInfoStatic) StaticFunction;
+    StaticSolver<StaticFunction, BFGSPolicy<2>, LineSearchNocedalPolicy<StaticFunction>>(objFuncInfoStatic, initialParameters).solve(result);
+    std::cout << "------------ BFGS, Nocedal Line Search, Exact Derivative, Static Dispatch --------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     return 0;
 }
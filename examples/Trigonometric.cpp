@@ -2,6 +2,8 @@
 
 #include <Optimization/LineSearchBackTrack.hpp>
 #include <Optimization/BFGS.hpp>
+#include <Optimization/Newton.hpp>
+#include <Optimization/SR1.hpp>
 #include <Optimization/SteepestDescent.hpp>
 
 
@@ -83,61 +85,108 @@ void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
     return;
 }
 
+void hessFunc(const Eigen::VectorXd & parameters, Eigen::MatrixXd & hessian)
+{
+    Eigen::VectorXd objFuncPartValue(m);
+    Eigen::MatrixXd gradFuncPartValue(m, n);
+
+    objFuncPart(parameters, objFuncPartValue);
+    gradFuncPart(parameters, gradFuncPartValue);
+
+    // The Hessian of the i-th part is diag(cos(x)) plus (i cos(x_i) + sin(x_i)) at (i, i).
+    hessian = 2 * gradFuncPartValue.transpose() * gradFuncPartValue;
+    for (int j = 0; j < n; j++)
+    {
+        hessian(j, j) += 2 * objFuncPartValue.sum() * std::cos(parameters(j));
+        hessian(j, j) += 2 * objFuncPartValue(j) * (j * std::cos(parameters(j)) + std::sin(parameters(j)));
+    }
+
+    return;
+}
+
 int main()
 {
-    std::shared_ptr<BaseAlgorithm> algorithm;
-    Function objFuncInfoExactDerivative(objFunc, gradFunc);
-    Function objFuncInfoApproxDerivative(objFunc);
+    std::shared_ptr<BaseAlgorithm<>> algorithm;
+    Function<> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Function<> objFuncInfoApproxDerivative(objFunc);
+    Function<> objFuncInfoExactHessian(objFunc, gradFunc, nullptr, hessFunc);
     Eigen::VectorXd initialParameters = Eigen::VectorXd::Constant(n, 1.0/n);
     Result result;
 
     // Steepest Descent, Nocedal Line Search, Exact Derivative
-    SteepestDescent(objFuncInfoExactDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------- Steepest Descent, Nocedal Line Search, Exact Derivative ------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Nocedal Line Search, Exact Derivative
-    BFGS(objFuncInfoExactDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoExactDerivative, initialParameters).solve(result);
     std::cout << "------------------- BFGS, Nocedal Line Search, Exact Derivative ------------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // Steepest Descent, Nocedal Line Search, Approximate Derivative
-    SteepestDescent(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    SteepestDescent<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------- Steepest Descent, Nocedal Line Search, Approximate Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
     
     // BFGS, Nocedal Line Search, Approximate Derivative
-    BFGS(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    BFGS<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
     std::cout << "----------------- BFGS, Nocedal Line Search, Approximate Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------ Steepest Descent, Backtracking Line Search, Exact Derivative --------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Exact Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoExactDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoExactDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoExactDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
     algorithm->solve(result);
     std::cout << "------------------ BFGS, Backtracking Line Search, Exact Derivative --------------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // Steepest Descent, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<SteepestDescent>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<SteepestDescent<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------- Steepest Descent, Backtracking Line Search, Approximate Derivative -----------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
     // BFGS, Backtracking Line Search, Approximate Derivative
-    algorithm = std::make_shared<BFGS>(objFuncInfoApproxDerivative, initialParameters);
-    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack>(objFuncInfoApproxDerivative));
+    algorithm = std::make_shared<BFGS<>>(objFuncInfoApproxDerivative, initialParameters);
+    algorithm->setLineSearch(std::make_shared<LineSearchBackTrack<>>(objFuncInfoApproxDerivative));
     algorithm->solve(result);
     std::cout << "--------------- BFGS, Backtracking Line Search, Approximate Derivative -----------------" << std::endl;
     std::cout << result << std::endl << std::endl;
 
+    // Newton, Nocedal Line Search, Exact Hessian
+    Newton<>(objFuncInfoExactHessian, initialParameters).solve(result);
+    std::cout << "------------------- Newton, Nocedal Line Search, Exact Hessian -------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Newton, Nocedal Line Search, Approximate Hessian
+    Newton<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "---------------- Newton, Nocedal Line Search, Approximate Hessian ----------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // Newton, Nocedal Line Search, Approximate Derivative
+    Newton<>(objFuncInfoApproxDerivative, initialParameters).solve(result);
+    std::cout << "--------------- Newton, Nocedal Line Search, Approximate Derivative --------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // SR1, Trust Region, Exact Derivative
+    SR1<>(objFuncInfoExactDerivative, initialParameters).solve(result);
+    std::cout << "------------------------- SR1, Trust Region, Exact Derivative --------------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
+    // SR1, Steihaug Trust Region, Exact Derivative
+    SR1<> sr1(objFuncInfoExactDerivative, initialParameters);
+    sr1.getSubproblem().setMaxNumExactParameters(0);
+    sr1.solve(result);
+    std::cout << "--------------------- SR1, Steihaug Trust Region, Exact Derivative ---------------------" << std::endl;
+    std::cout << result << std::endl << std::endl;
+
     return 0;
 }
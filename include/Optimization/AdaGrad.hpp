@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <Optimization/StochasticAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Mini-batch AdaGrad, which scales the learning rate of each parameter with the inverse
+ *  root of its accumulated squared gradients,
+ *
+ *      G = G + g^2,   x = x - learningRate g / (sqrt(G) + epsilon),
+ *
+ *  so rarely updated parameters keep large steps. The default learning rate is a constant 0.1.
+ *
+ *  John Duchi, Elad Hazan and Yoram Singer, Adaptive Subgradient Methods for Online Learning
+ *  and Stochastic Optimization, Journal of Machine Learning Research, 12, 2011
+ */
+
+template <int Dim = Eigen::Dynamic>
+class AdaGrad : public StochasticAlgorithm<Dim>
+{
+    public:
+        typedef typename StochasticAlgorithm<Dim>::Vector       Vector;
+        typedef typename StochasticAlgorithm<Dim>::LearningRate LearningRate;
+
+    public:
+        AdaGrad(StochasticFunction<Dim> & objFunc,
+                const Vector &            initialParameters,
+                double                    gradTol = 1e-9,
+                double                    relTol = 1e-9,
+                unsigned int              maxNumEpochs = 100,
+                LearningRate              learningRate = ConstantLearningRate(0.1));
+
+        ~AdaGrad();
+
+        /*
+         *  Added to the root of the accumulated squared gradients. The default value is 1e-8.
+         */
+
+        void setEpsilon(double epsilon);
+        double getEpsilon() const;
+
+    private:
+        void initializeState(Eigen::Index numParameters) override;
+
+        void updateParameters(const Vector & gradient,
+                              double         learningRate,
+                              Vector &       parameters) override;
+
+    private:
+        double epsilon;
+        Vector sumSquaredGradients;
+};
+
+template <int Dim>
+AdaGrad<Dim>::AdaGrad(StochasticFunction<Dim> & objFunc,
+                      const Vector &            initialParameters,
+                      double                    gradTol,
+                      double                    relTol,
+                      unsigned int              maxNumEpochs,
+                      LearningRate              learningRate)
+                      :
+                      StochasticAlgorithm<Dim>(objFunc,
+                                               initialParameters,
+                                               gradTol,
+                                               relTol,
+                                               maxNumEpochs,
+                                               learningRate)
+{
+    setEpsilon(1e-8);
+}
+
+template <int Dim>
+AdaGrad<Dim>::~AdaGrad()
+{
+
+}
+
+template <int Dim>
+void AdaGrad<Dim>::initializeState(Eigen::Index numParameters)
+{
+    sumSquaredGradients.setZero(numParameters);
+}
+
+template <int Dim>
+void AdaGrad<Dim>::updateParameters(const Vector & gradient,
+                                    double         learningRate,
+                                    Vector &       parameters)
+{
+    sumSquaredGradients += gradient.cwiseAbs2();
+    parameters.array() -= learningRate * gradient.array() / (sumSquaredGradients.array().sqrt() + epsilon);
+}
+
+template <int Dim>
+void AdaGrad<Dim>::setEpsilon(double epsilon)
+{
+    if (epsilon <= 0.0)
+    {
+        throw std::invalid_argument("Epsilon must be greater than zero.");
+    }
+    this->epsilon = epsilon;
+}
+
+template <int Dim>
+double AdaGrad<Dim>::getEpsilon() const
+{
+    return epsilon;
+}
+
+extern template class AdaGrad<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Optimization/StochasticAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Mini-batch Adam, which divides an exponential moving average of the gradients by the root
+ *  of one of the squared gradients, both corrected for their initialization at zero,
+ *
+ *      m = beta1 m + (1 - beta1) g,   v = beta2 v + (1 - beta2) g^2,
+ *      x = x - learningRate m / (1 - beta1^t) / (sqrt(v / (1 - beta2^t)) + epsilon)
+ *
+ *  after t updates. The default learning rate is a constant 0.001.
+ *
+ *  Diederik P. Kingma and Jimmy Ba, Adam: A Method for Stochastic Optimization,
+ *  International Conference on Learning Representations, 2015
+ */
+
+template <int Dim = Eigen::Dynamic>
+class Adam : public StochasticAlgorithm<Dim>
+{
+    public:
+        typedef typename StochasticAlgorithm<Dim>::Vector       Vector;
+        typedef typename StochasticAlgorithm<Dim>::LearningRate LearningRate;
+
+    public:
+        Adam(StochasticFunction<Dim> & objFunc,
+             const Vector &            initialParameters,
+             double                    gradTol = 1e-9,
+             double                    relTol = 1e-9,
+             unsigned int              maxNumEpochs = 100,
+             LearningRate              learningRate = ConstantLearningRate(0.001));
+
+        ~Adam();
+
+        /*
+         *  Decay rates of the moving averages in [0, 1). The default values are 0.9 and 0.999.
+         */
+
+        void setDecayRates(double beta1, double beta2);
+        double getBeta1() const;
+        double getBeta2() const;
+
+        /*
+         *  Added to the root of the second moment estimate. The default value is 1e-8.
+         */
+
+        void setEpsilon(double epsilon);
+        double getEpsilon() const;
+
+    private:
+        void initializeState(Eigen::Index numParameters) override;
+
+        void updateParameters(const Vector & gradient,
+                              double         learningRate,
+                              Vector &       parameters) override;
+
+    private:
+        double beta1;
+        double beta2;
+        double epsilon;
+
+        // Powers beta1^t and beta2^t for the bias correction.
+        double beta1Power;
+        double beta2Power;
+
+        Vector firstMoment;
+        Vector secondMoment;
+};
+
+template <int Dim>
+Adam<Dim>::Adam(StochasticFunction<Dim> & objFunc,
+                const Vector &            initialParameters,
+                double                    gradTol,
+                double                    relTol,
+                unsigned int              maxNumEpochs,
+                LearningRate              learningRate)
+                :
+                StochasticAlgorithm<Dim>(objFunc,
+                                         initialParameters,
+                                         gradTol,
+                                         relTol,
+                                         maxNumEpochs,
+                                         learningRate)
+{
+    setDecayRates(0.9, 0.999);
+    setEpsilon(1e-8);
+}
+
+template <int Dim>
+Adam<Dim>::~Adam()
+{
+
+}
+
+template <int Dim>
+void Adam<Dim>::initializeState(Eigen::Index numParameters)
+{
+    firstMoment.setZero(numParameters);
+    secondMoment.setZero(numParameters);
+
+    beta1Power = 1.0;
+    beta2Power = 1.0;
+}
+
+template <int Dim>
+void Adam<Dim>::updateParameters(const Vector & gradient,
+                                 double         learningRate,
+                                 Vector &       parameters)
+{
+    beta1Power *= beta1;
+    beta2Power *= beta2;
+
+    firstMoment = beta1 * firstMoment + (1.0 - beta1) * gradient;
+    secondMoment = beta2 * secondMoment + (1.0 - beta2) * gradient.cwiseAbs2();
+
+    // Bias corrections folded into the step length and epsilon.
+    const double stepLength = learningRate * std::sqrt(1.0 - beta2Power) / (1.0 - beta1Power);
+    const double scaledEpsilon = epsilon * std::sqrt(1.0 - beta2Power);
+
+    parameters.array() -= stepLength * firstMoment.array() / (secondMoment.array().sqrt() + scaledEpsilon);
+}
+
+template <int Dim>
+void Adam<Dim>::setDecayRates(double beta1, double beta2)
+{
+    if (beta1 < 0.0 || beta1 >= 1.0 || beta2 < 0.0 || beta2 >= 1.0)
+    {
+        throw std::invalid_argument("Decay rates must be in [0, 1).");
+    }
+    this->beta1 = beta1;
+    this->beta2 = beta2;
+}
+
+template <int Dim>
+double Adam<Dim>::getBeta1() const
+{
+    return beta1;
+}
+
+template <int Dim>
+double Adam<Dim>::getBeta2() const
+{
+    return beta2;
+}
+
+template <int Dim>
+void Adam<Dim>::setEpsilon(double epsilon)
+{
+    if (epsilon <= 0.0)
+    {
+        throw std::invalid_argument("Epsilon must be greater than zero.");
+    }
+    this->epsilon = epsilon;
+}
+
+template <int Dim>
+double Adam<Dim>::getEpsilon() const
+{
+    return epsilon;
+}
+
+extern template class Adam<Eigen::Dynamic>;
+
+}
@@ -1,41 +1,325 @@
 #pragma once
 
+#include <stdexcept>
+
 #include <Optimization/BaseAlgorithm.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class BFGS : public BaseAlgorithm 
+/*
+ *  Direction policy for StaticSolver.
+ *
+ *  A line search enforcing only the Armijo condition, e.g. LineSearchBackTrack, does not
+ *  guarantee the curvature condition s^T y > 0, without which the update loses positive
+ *  definiteness. Therefore the secant pair is damped as proposed by Powell, and an update is
+ *  skipped if s^T y is still too small. Optionally, see setScaling, the initial inverse
+ *  Hessian is rescaled before the first update with s^T y / y^T y, which approximates the
+ *  inverse of the curvature along the first step.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class BFGSPolicy
 {
     public:
-        BFGS(Function &              objFuncInfo,
-             const Eigen::VectorXd & initialParameters,
-             double                  gradTol = 1e-9,
-             double                  relTol = 1e-9,
-             unsigned int            maxNumIterations = 100000,
-             LineSearch::Ptr         lineSearch = nullptr);
-        
+        typedef Eigen::Matrix<double, Dim, 1>   Vector;
+        typedef Eigen::Matrix<double, Dim, Dim> Matrix;
+
+    public:
+        BFGSPolicy(bool   damping = true,
+                   bool   scaling = false,
+                   double skipTol = 1e-8);
+
+        void initialDirection(const Vector & parameters,
+                              const Vector & gradient,
+                              Vector &       direction);
+
+        void updateDirection(const Vector & parameters,
+                             const Vector & gradient,
+                             const Vector & lastParameters,
+                             const Vector & lastGradient,
+                             Vector &       direction);
+
+        /*
+         *  Whether the secant pair is damped. The default value is true.
+         */
+
+        inline void setDamping(bool damping)
+        {
+            this->damping = damping;
+        }
+
+        inline bool getDamping() const
+        {
+            return damping;
+        }
+
+        /*
+         *  Whether the initial inverse Hessian is rescaled after the first step. It often
+         *  saves iterations when the gradient is badly scaled, but may cost some when the
+         *  identity is already a good initial matrix. The default value is false.
+         */
+
+        inline void setScaling(bool scaling)
+        {
+            this->scaling = scaling;
+        }
+
+        inline bool getScaling() const
+        {
+            return scaling;
+        }
+
+        /*
+         *  An update is skipped if s^T y <= skipTol * ||s|| ||y||. The skipTol must be in
+         *  [0, 1). The default value is 1e-8.
+         */
+
+        void setSkipTol(double skipTol);
+        double getSkipTol() const;
+
+        /*
+         *  Number of updates skipped since the initial direction.
+         */
+
+        inline unsigned int getNumSkippedUpdates() const
+        {
+            return numSkippedUpdates;
+        }
+
+    private:
+        bool         damping;
+        bool         scaling;
+        double       skipTol;
+
+        bool         firstUpdate;
+        unsigned int numSkippedUpdates;
+
+        Matrix       inverseHessian;
+        Vector       s;
+        Vector       y;
+        Vector       Hy;
+};
+
+template <int Dim = Eigen::Dynamic>
+class BFGS : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector Vector;
+
+    public:
+        BFGS(Function<Dim> &               objFuncInfo,
+             const Vector &                initialParameters,
+             double                        gradTol = 1e-9,
+             double                        relTol = 1e-9,
+             unsigned int                  maxNumIterations = 100000,
+             typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
         ~BFGS();
-        
+
+        inline void setDamping(bool damping)
+        {
+            policy.setDamping(damping);
+        }
+
+        inline bool getDamping() const
+        {
+            return policy.getDamping();
+        }
+
+        inline void setScaling(bool scaling)
+        {
+            policy.setScaling(scaling);
+        }
+
+        inline bool getScaling() const
+        {
+            return policy.getScaling();
+        }
+
+        inline void setSkipTol(double skipTol)
+        {
+            policy.setSkipTol(skipTol);
+        }
+
+        inline double getSkipTol() const
+        {
+            return policy.getSkipTol();
+        }
+
+        inline unsigned int getNumSkippedUpdates() const
+        {
+            return policy.getNumSkippedUpdates();
+        }
+
     private:
-        void initialDirection(const Eigen::VectorXd & gradient,
-                              Eigen::VectorXd &       direction) override;
-        
-        void updateDirection(const Eigen::VectorXd & parameters,
-                             const Eigen::VectorXd & gradient,
-                             const Eigen::VectorXd & lastParameters,
-                             const Eigen::VectorXd & lastGradient,
-                             Eigen::VectorXd &       direction) override;
-        
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
     private:
-        Eigen::MatrixXd inverseHessian;
-        Eigen::VectorXd s;
-        Eigen::VectorXd y;
-        Eigen::MatrixXd ysOuter;
-        Eigen::MatrixXd ssOuter;
-        Eigen::MatrixXd A;
-        Eigen::MatrixXd B;    
+        BFGSPolicy<Dim> policy;
 };
 
+template <int Dim>
+BFGSPolicy<Dim>::BFGSPolicy(bool   damping,
+                            bool   scaling,
+                            double skipTol)
+                            :
+                            damping(damping),
+                            scaling(scaling),
+                            firstUpdate(true),
+                            numSkippedUpdates(0)
+{
+    // Fixed-size members are not initialized by Eigen, dynamic ones are empty.
+    inverseHessian.setZero();
+    s.setZero();
+    y.setZero();
+    Hy.setZero();
+
+    setSkipTol(skipTol);
+}
+
+template <int Dim>
+void BFGSPolicy<Dim>::initialDirection(const Vector & parameters,
+                                       const Vector & gradient,
+                                       Vector &       direction)
+{
+    const Eigen::Index numParameters = gradient.size();
+
+    // Compute initial inverse of Hessian
+    inverseHessian = Matrix::Identity(numParameters, numParameters) / gradient.norm();
+
+    firstUpdate       = true;
+    numSkippedUpdates = 0;
+
+    // Compute initial direction
+    direction.noalias() = -inverseHessian * gradient;
+}
+
+/*
+ *  Implements the BFGS Algorithm 6.1 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 140
+ *  with the scaling (6.20) of the initial inverse Hessian on Page 143 and the damping of
+ *  Procedure 18.2 on Page 537.
+ */
+
+template <int Dim>
+void BFGSPolicy<Dim>::updateDirection(const Vector & parameters,
+                                      const Vector & gradient,
+                                      const Vector & lastParameters,
+                                      const Vector & lastGradient,
+                                      Vector &       direction)
+{
+    s = parameters - lastParameters;
+    y = gradient - lastGradient;
+
+    double ysInner = y.dot(s);
+
+    if (damping)
+    {
+        // The last direction is -H g, hence B s = -stepLength * g for the Hessian
+        // approximation B, the inverse of H, and no linear system has to be solved.
+        const double stepLength = s.dot(direction) / direction.squaredNorm();
+        const double sBsInner = -stepLength * s.dot(lastGradient);
+
+        if (ysInner < 0.2 * sBsInner)
+        {
+            // Interpolate between y and B s, so that s^T y = 0.2 s^T B s.
+            const double theta = 0.8 * sBsInner / (sBsInner - ysInner);
+
+            y = theta * y - ((1.0 - theta) * stepLength) * lastGradient;
+            ysInner = y.dot(s);
+        }
+    }
+
+    if (ysInner <= skipTol * s.norm() * y.norm())
+    {
+        // Keep the inverse Hessian, which is positive definite.
+        ++numSkippedUpdates;
+        direction.noalias() = -inverseHessian * gradient;
+        return;
+    }
+
+    if (firstUpdate && scaling)
+    {
+        inverseHessian.setIdentity();
+        inverseHessian *= ysInner / y.squaredNorm();
+    }
+
+    firstUpdate = false;
+
+    // Update approximative inverse Hessian with the rank two form of (6.17), which costs
+    // O(n^2) instead of the O(n^3) of the matrix products.
+    const double rho = 1.0 / ysInner;
+
+    Hy.noalias() = inverseHessian * y;
+    const double yHyInner = y.dot(Hy);
+
+    inverseHessian.noalias() -= (rho * Hy) * s.transpose();
+    inverseHessian.noalias() -= (rho * s) * Hy.transpose();
+    inverseHessian.noalias() += ((rho * rho * yHyInner + rho) * s) * s.transpose();
+
+    // Compute new direction
+    direction.noalias() = -inverseHessian * gradient;
+}
+
+template <int Dim>
+void BFGSPolicy<Dim>::setSkipTol(double skipTol)
+{
+    if (skipTol < 0.0 || skipTol >= 1.0)
+    {
+        throw std::invalid_argument("Skip tolerance must be in [0, 1).");
+    }
+
+    this->skipTol = skipTol;
+}
+
+template <int Dim>
+double BFGSPolicy<Dim>::getSkipTol() const
+{
+    return skipTol;
+}
+
+template <int Dim>
+BFGS<Dim>::BFGS(Function<Dim> &               objFuncInfo,
+                const Vector &                initialParameters,
+                double                        gradTol,
+                double                        relTol,
+                unsigned int                  maxNumIterations,
+                typename LineSearch<Dim>::Ptr lineSearch)
+                :
+                BaseAlgorithm<Dim>(objFuncInfo,
+                                   initialParameters,
+                                   gradTol,
+                                   relTol,
+                                   maxNumIterations,
+                                   lineSearch)
+{
+
+}
+
+template <int Dim>
+BFGS<Dim>::~BFGS()
+{
+
+}
+
+extern template class BFGSPolicy<Eigen::Dynamic>;
+extern template class BFGS<Eigen::Dynamic>;
+
 }
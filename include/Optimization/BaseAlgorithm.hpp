@@ -2,30 +2,54 @@
 
 #include <string>
 
+#include <Optimization/InitialStep.hpp>
 #include <Optimization/LineSearchNocedal.hpp>
 #include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchExact.hpp>
 #include <Optimization/Result.hpp>
+#include <Optimization/StaticSolver.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class BaseAlgorithm 
+template <int Dim = Eigen::Dynamic>
+class BaseAlgorithm
 {
     public:
-        BaseAlgorithm(Function &              objFunc,
-                      const Eigen::VectorXd & initialParameters,
-                      double                  gradTol,
-                      double                  relTol,
-                      unsigned int            maxNumIterations,
-                      LineSearch::Ptr         lineSearch = nullptr);
+        typedef typename Function<Dim>::Vector Vector;
+
+    public:
+        BaseAlgorithm(Function<Dim> &               objFunc,
+                      const Vector &                initialParameters,
+                      double                        gradTol,
+                      double                        relTol,
+                      unsigned int                  maxNumIterations,
+                      typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        // The solver refers back to this algorithm, hence it is not copyable.
+        BaseAlgorithm(const BaseAlgorithm &) = delete;
+        BaseAlgorithm & operator=(const BaseAlgorithm &) = delete;
 
         virtual ~BaseAlgorithm();
 
         virtual void solve(Result & result);
 
-        void setLineSearch(LineSearch::Ptr lineSearch);
-        LineSearch::Ptr getLineSearch() const;
+        void setLineSearch(typename LineSearch<Dim>::Ptr lineSearch);
+        typename LineSearch<Dim>::Ptr getLineSearch() const;
+
+        /*
+         *  The strategy predicting the trial step length of each line search. The default,
+         *  selected by nullptr, is InitialStepQuadratic.
+         */
+
+        void setInitialStep(typename InitialStep<Dim>::Ptr initialStep);
+        typename InitialStep<Dim>::Ptr getInitialStep() const;
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        unsigned int getNumIterations() const;
 
         void setMaxNumIterations(unsigned int maxNumIterations);
         unsigned int getMaxNumIterations() const;
@@ -35,34 +59,271 @@ class BaseAlgorithm
 
         void setRelativeTol(double relTol);
         double getRelativeTol() const;
-        
+
     private:
-        virtual void initialDirection(const Eigen::VectorXd & gradient,
-                                      Eigen::VectorXd &       direction) = 0;
+        virtual void initialDirection(const Vector & parameters,
+                                      const Vector & gradient,
+                                      Vector &       direction) = 0;
+
+        virtual void updateDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     Vector &       direction) = 0;
 
-        virtual void updateDirection(const Eigen::VectorXd & parameters,
-                                     const Eigen::VectorXd & gradient,
-                                     const Eigen::VectorXd & lastParameters,
-                                     const Eigen::VectorXd & lastGradient,
-                                     Eigen::VectorXd &       direction) = 0;
+        /*
+         *  Policies of StaticSolver forwarding to the virtual methods.
+         */
 
-        static inline double computeGradNorm(const Eigen::VectorXd & gradient) 
+        class DirectionAdapter
         {
-            return gradient.lpNorm<Eigen::Infinity>();
-        }
-        
+            public:
+                DirectionAdapter(BaseAlgorithm & algorithm) : algorithm(&algorithm) { }
+
+                inline void initialDirection(const Vector & parameters,
+                                             const Vector & gradient,
+                                             Vector &       direction)
+                {
+                    algorithm->initialDirection(parameters, gradient, direction);
+                }
+
+                inline void updateDirection(const Vector & parameters,
+                                            const Vector & gradient,
+                                            const Vector & lastParameters,
+                                            const Vector & lastGradient,
+                                            Vector &       direction)
+                {
+                    algorithm->updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+                }
+
+            private:
+                BaseAlgorithm * algorithm;
+        };
+
+        class LineSearchAdapter
+        {
+            public:
+                LineSearchAdapter(LineSearch<Dim> * lineSearch = nullptr) : lineSearch(lineSearch) { }
+
+                inline bool search(const Vector & lastParameters,
+                                   const Vector & lastGradient,
+                                   const Vector & direction,
+                                   Vector &       parameters,
+                                   double &       funcValue,
+                                   Vector &       gradient,
+                                   double &       stepLength)
+                {
+                    return lineSearch->search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+                }
+
+            private:
+                LineSearch<Dim> * lineSearch;
+        };
+
+        class InitialStepAdapter
+        {
+            public:
+                InitialStepAdapter(InitialStep<Dim> * initialStep = nullptr) : initialStep(initialStep) { }
+
+                inline double initialStepLength(const Vector & gradient,
+                                                const Vector & direction)
+                {
+                    return initialStep->initialStepLength(gradient, direction);
+                }
+
+                inline double nextStepLength(const Vector & parameters,
+                                             const Vector & gradient,
+                                             double         funcValue,
+                                             const Vector & lastParameters,
+                                             const Vector & lastGradient,
+                                             double         lastFuncValue,
+                                             double         lastGradDotDir,
+                                             double         lastStepLength,
+                                             const Vector & direction)
+                {
+                    return initialStep->nextStepLength(parameters, gradient, funcValue, lastParameters, lastGradient,
+                                                       lastFuncValue, lastGradDotDir, lastStepLength, direction);
+                }
+
+            private:
+                InitialStep<Dim> * initialStep;
+        };
+
     protected:
-        Eigen::VectorXd        initialParameters;
-        Eigen::VectorXd::Index numParameters;
+        Eigen::Index                   numParameters;
+
+        typename LineSearch<Dim>::Ptr  lineSearch;
+
+        typename InitialStep<Dim>::Ptr initialStep;
 
-        double                 gradTol;
-        double                 relTol;
-        unsigned int           numIterations;
-        unsigned int           maxNumIterations;
-        
-        LineSearch::Ptr        lineSearch;
+        Function<Dim> *                objFunc;
 
-        Function *             objFunc;
+    private:
+        StaticSolver<Function<Dim>, DirectionAdapter, LineSearchAdapter, InitialStepAdapter> solver;
 };
 
+template <int Dim>
+BaseAlgorithm<Dim>::BaseAlgorithm(Function<Dim> &               objFunc,
+                                  const Vector &                initialParameters,
+                                  double                        gradTol,
+                                  double                        relTol,
+                                  unsigned int                  maxNumIterations,
+                                  typename LineSearch<Dim>::Ptr lineSearch)
+                                  :
+                                  solver(objFunc,
+                                         initialParameters,
+                                         DirectionAdapter(*this),
+                                         LineSearchAdapter(),
+                                         gradTol,
+                                         relTol,
+                                         maxNumIterations)
+{
+    numParameters = initialParameters.size();
+
+    this->objFunc = (&objFunc);
+
+    setLineSearch(lineSearch);
+    setInitialStep(nullptr);
+}
+
+template <int Dim>
+BaseAlgorithm<Dim>::~BaseAlgorithm()
+{
+
+}
+
+/*
+ *  The iterations are carried out by StaticSolver, whose policies forward to the virtual
+ *  direction methods and to the line search of this algorithm. The solver keeps its
+ *  workspace between calls, hence repeated solves do not allocate.
+ */
+
+template <int Dim>
+void BaseAlgorithm<Dim>::solve(Result & result)
+{
+    lineSearch->reset();
+
+    try
+    {
+        solver.solve(result);
+    }
+    catch (...)
+    {
+        lineSearch->finish();
+        throw;
+    }
+
+    lineSearch->finish();
+    lineSearch->report(result);
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setLineSearch(typename LineSearch<Dim>::Ptr lineSearch)
+{
+    if (lineSearch == nullptr)
+    {
+        // A quadratic function is minimized exactly along the direction.
+        QuadraticFunction<Dim> * quadraticFunc = dynamic_cast<QuadraticFunction<Dim> *>(objFunc);
+
+        if (quadraticFunc != nullptr)
+        {
+            this->lineSearch = std::make_shared<LineSearchExact<Dim>>(*quadraticFunc);
+        }
+        else
+        {
+            this->lineSearch = std::make_shared<LineSearchNocedal<Dim>>(*objFunc);
+        }
+    }
+    else
+    {
+        this->lineSearch = lineSearch;
+    }
+
+    solver.getLineSearch() = LineSearchAdapter(this->lineSearch.get());
+}
+
+template <int Dim>
+typename LineSearch<Dim>::Ptr BaseAlgorithm<Dim>::getLineSearch() const
+{
+    return lineSearch;
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setInitialStep(typename InitialStep<Dim>::Ptr initialStep)
+{
+    if (initialStep == nullptr)
+    {
+        this->initialStep = std::make_shared<InitialStepQuadratic<Dim>>();
+    }
+    else
+    {
+        this->initialStep = initialStep;
+    }
+
+    solver.getInitialStep() = InitialStepAdapter(this->initialStep.get());
+}
+
+template <int Dim>
+typename InitialStep<Dim>::Ptr BaseAlgorithm<Dim>::getInitialStep() const
+{
+    return initialStep;
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    numParameters = initialParameters.size();
+    solver.setInitialParameters(initialParameters);
+}
+
+template <int Dim>
+const typename BaseAlgorithm<Dim>::Vector & BaseAlgorithm<Dim>::getInitialParameters() const
+{
+    return solver.getInitialParameters();
+}
+
+template <int Dim>
+unsigned int BaseAlgorithm<Dim>::getNumIterations() const
+{
+    return solver.getNumIterations();
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    solver.setMaxNumIterations(maxNumIterations);
+}
+
+template <int Dim>
+unsigned int BaseAlgorithm<Dim>::getMaxNumIterations() const
+{
+    return solver.getMaxNumIterations();
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setGradientTol(double gradTol)
+{
+    solver.setGradientTol(gradTol);
+}
+
+template <int Dim>
+double BaseAlgorithm<Dim>::getGradientTol() const
+{
+    return solver.getGradientTol();
+}
+
+template <int Dim>
+void BaseAlgorithm<Dim>::setRelativeTol(double relTol)
+{
+    solver.setRelativeTol(relTol);
+}
+
+template <int Dim>
+double BaseAlgorithm<Dim>::getRelativeTol() const
+{
+    return solver.getRelativeTol();
+}
+
+extern template class BaseAlgorithm<Eigen::Dynamic>;
+
 }
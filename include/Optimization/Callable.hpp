@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace Optimization
+{
+
+/*
+ *  Type-erased wrapper of a callable, similar to std::function but with a small buffer
+ *  which is never exceeded. The callable, e.g. a lambda with captured problem data, is
+ *  stored inside the wrapper, hence constructing, copying and calling never allocates.
+ *  Callables larger than Capacity bytes are rejected at compile time. In that case capture
+ *  the problem data by reference or pointer instead.
+ */
+
+template <class Signature, std::size_t Capacity = 4 * sizeof(void *)>
+class Callable;
+
+template <class R, class... Args, std::size_t Capacity>
+class Callable<R(Args...), Capacity>
+{
+    public:
+        Callable() : invoker(nullptr), manager(nullptr) { }
+
+        Callable(std::nullptr_t) : Callable() { }
+
+        template <class F,
+                  class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Callable>::value>::type>
+        Callable(F && func) : Callable()
+        {
+            typedef typename std::decay<F>::type Func;
+
+            static_assert(sizeof(Func) <= Capacity,
+                          "The callable does not fit into the buffer of Callable. Capture its data by reference.");
+            static_assert(alignof(Func) <= alignof(std::max_align_t),
+                          "The callable is over-aligned for the buffer of Callable.");
+
+            if constexpr (std::is_pointer<typename std::remove_reference<F>::type>::value)
+            {
+                // A null function pointer results in an empty callable.
+                if (func == nullptr)
+                {
+                    return;
+                }
+            }
+
+            new (storage) Func(std::forward<F>(func));
+            invoker = &invoke<Func>;
+            manager = &manage<Func>;
+        }
+
+        Callable(const Callable & other) : Callable()
+        {
+            if (other.manager != nullptr)
+            {
+                other.manager(Copy, storage, other.storage);
+                invoker = other.invoker;
+                manager = other.manager;
+            }
+        }
+
+        Callable & operator=(const Callable & other)
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.manager != nullptr)
+                {
+                    other.manager(Copy, storage, other.storage);
+                    invoker = other.invoker;
+                    manager = other.manager;
+                }
+            }
+
+            return *this;
+        }
+
+        ~Callable()
+        {
+            reset();
+        }
+
+        inline R operator()(Args... args)
+        {
+            return invoker(storage, std::forward<Args>(args)...);
+        }
+
+        inline explicit operator bool() const
+        {
+            return invoker != nullptr;
+        }
+
+    private:
+        enum Operation
+        {
+            Copy,
+            Destroy
+        };
+
+        template <class Func>
+        static R invoke(void * storage, Args &&... args)
+        {
+            return (*static_cast<Func *>(storage))(std::forward<Args>(args)...);
+        }
+
+        template <class Func>
+        static void manage(Operation operation, void * destination, const void * source)
+        {
+            if (operation == Copy)
+            {
+                new (destination) Func(*static_cast<const Func *>(source));
+            }
+            else
+            {
+                static_cast<Func *>(destination)->~Func();
+            }
+        }
+
+        inline void reset()
+        {
+            if (manager != nullptr)
+            {
+                manager(Destroy, storage, nullptr);
+            }
+            invoker = nullptr;
+            manager = nullptr;
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char storage[Capacity];
+
+        R    (* invoker)(void * storage, Args &&... args);
+        void (* manager)(Operation operation, void * destination, const void * source);
+};
+
+}
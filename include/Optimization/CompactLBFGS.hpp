@@ -0,0 +1,632 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Dense>
+
+
+namespace Optimization
+{
+
+/*
+ *  Limited-memory BFGS matrix in the compact representation of Byrd, Nocedal and Schnabel,
+ *
+ *      B = theta I - W M W^T,   W = [Y, theta S],
+ *
+ *  where the columns of S and Y are the last m secant pairs s_i and y_i, and M is the inverse
+ *  of a symmetric 2k x 2k matrix for k <= m stored pairs. Products with B and with its inverse
+ *  H as well as solves with B restricted to a subset of the parameters cost O(mn).
+ *
+ *  S and Y are stored as column-major n x m panels used as ring buffers, so every product
+ *  with a panel is a single pass over contiguous memory. The inner products S^T S, S^T Y and
+ *  Y^T Y, from which the middle matrix is formed, are updated with O(mn) work per pair.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class CompactLBFGS
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1>              Vector;
+        typedef Eigen::Matrix<double, Dim, Eigen::Dynamic> Panel;
+        typedef Eigen::VectorXd                            SmallVector;
+        typedef Eigen::MatrixXd                            SmallMatrix;
+
+    public:
+        CompactLBFGS(unsigned int memory = 5,
+                     double       skipTol = 1e-8);
+
+        /*
+         *  Removes all pairs, so that B is the identity, and allocates the storage for the
+         *  given number of parameters.
+         */
+
+        void reset(Eigen::Index numParameters);
+
+        /*
+         *  Adds the pair s = x_{k+1} - x_k, y = g_{k+1} - g_k and drops the oldest one if m
+         *  pairs are stored. The pair is skipped if s^T y <= skipTol * ||s|| ||y||, which
+         *  keeps B positive definite. Returns whether the pair was added.
+         */
+
+        bool update(const Vector & s,
+                    const Vector & y);
+
+        /*
+         *  result = B v
+         */
+
+        void applyHessian(const Vector & v,
+                          Vector &       result);
+
+        /*
+         *  result = H v with the inverse H of B.
+         */
+
+        void applyInverseHessian(const Vector & v,
+                                 Vector &       result);
+
+        /*
+         *  Solves (Z^T B Z) result = rhs, where the columns of Z are the unit vectors of the
+         *  given parameter indices, by the Sherman-Morrison-Woodbury formula. This costs
+         *  O(m^2 |indices|) and is the subspace solve of bound-constrained methods.
+         */
+
+        void solveReduced(const std::vector<Eigen::Index> & indices,
+                          const SmallVector &               rhs,
+                          SmallVector &                     result);
+
+        /*
+         *  result = W^T v with 2k entries, the first k belonging to Y, oldest pair first.
+         */
+
+        void applyWTranspose(const Vector & v,
+                             SmallVector &  result);
+
+        /*
+         *  result = W p for a vector p with 2k entries, ordered as in applyWTranspose.
+         */
+
+        void applyW(const SmallVector & p,
+                    Vector &            result) const;
+
+        /*
+         *  result = W^T e_i, the i-th row of W.
+         */
+
+        void getWRow(Eigen::Index  i,
+                     SmallVector & result) const;
+
+        /*
+         *  result = M p for a vector p with 2k entries.
+         */
+
+        void applyMiddle(const SmallVector & p,
+                         SmallVector &       result);
+
+        /*
+         *  The multiple of the identity B_0 = theta I, which is y^T y / s^T y of the last
+         *  pair, or one without pairs.
+         */
+
+        inline double getTheta() const
+        {
+            return theta;
+        }
+
+        /*
+         *  Number of stored pairs k.
+         */
+
+        inline unsigned int getNumPairs() const
+        {
+            return numPairs;
+        }
+
+        /*
+         *  The maximum number m of stored pairs. Changing it removes all pairs. The default
+         *  value is 5.
+         */
+
+        void setMemory(unsigned int memory);
+        unsigned int getMemory() const;
+
+        /*
+         *  The skipTol must be in [0, 1). The default value is 1e-8.
+         */
+
+        void setSkipTol(double skipTol);
+        double getSkipTol() const;
+
+
+    private:
+        typedef Eigen::Ref<SmallVector> SmallRef;
+
+        inline Eigen::Index physicalIndex(Eigen::Index i) const
+        {
+            return (first + i) % memory;
+        }
+
+        void toLogical(Eigen::Index size,
+                       SmallRef     logical) const;
+
+        void shiftInnerProducts();
+
+        void factorizeMiddle();
+
+        void solveMiddle(SmallRef p) const;
+
+    private:
+        unsigned int                     memory;
+        double                           skipTol;
+
+        unsigned int                     numPairs;
+        unsigned int                     first;
+        double                           theta;
+
+        Panel                            S;
+        Panel                            Y;
+
+        // Inner products of the pairs, oldest pair first, i.e. SY(i, j) = s_i^T y_j.
+        SmallMatrix                      SS;
+        SmallMatrix                      SY;
+        SmallMatrix                      YY;
+
+        // M is applied through D = diag(s_i^T y_i), the strictly lower triangle L of S^T Y
+        // and the Cholesky factor J of theta S^T S + L D^{-1} L^T. All small matrices are
+        // allocated for m pairs, of which the leading k are used.
+        SmallVector                      D;
+        SmallMatrix                      L;
+        SmallMatrix                      J;
+
+        SmallVector                      physical;
+        SmallVector                      sv;
+        SmallVector                      yv;
+        SmallVector                      small;
+        SmallVector                      smallResult;
+
+        SmallMatrix                      reducedW;
+        SmallMatrix                      reducedN;
+        Eigen::PartialPivLU<SmallMatrix> reducedLU;
+};
+
+template <int Dim>
+CompactLBFGS<Dim>::CompactLBFGS(unsigned int memory,
+                                double       skipTol)
+                                :
+                                numPairs(0),
+                                first(0),
+                                theta(1.0)
+{
+    setMemory(memory);
+    setSkipTol(skipTol);
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::reset(Eigen::Index numParameters)
+{
+    numPairs = 0;
+    first    = 0;
+    theta    = 1.0;
+
+    S.resize(numParameters, memory);
+    Y.resize(numParameters, memory);
+
+    SS.resize(memory, memory);
+    SY.resize(memory, memory);
+    YY.resize(memory, memory);
+
+    D.resize(memory);
+    L.resize(memory, memory);
+    J.resize(memory, memory);
+
+    physical.resize(memory);
+    sv.resize(memory);
+    yv.resize(memory);
+    small.resize(2 * memory);
+    smallResult.resize(2 * memory);
+}
+
+template <int Dim>
+bool CompactLBFGS<Dim>::update(const Vector & s,
+                               const Vector & y)
+{
+    const double ysInner = y.dot(s);
+    const double yyInner = y.squaredNorm();
+
+    if (ysInner <= skipTol * s.norm() * std::sqrt(yyInner))
+    {
+        return false;
+    }
+
+    if (S.rows() != s.size())
+    {
+        reset(s.size());
+    }
+
+    if (numPairs == memory)
+    {
+        // Drop the oldest pair.
+        shiftInnerProducts();
+        first = (first + 1) % memory;
+        --numPairs;
+    }
+
+    const Eigen::Index k = numPairs;
+    const Eigen::Index last = physicalIndex(k);
+
+    S.col(last) = s;
+    Y.col(last) = y;
+
+    // Only the new row and column of the inner products are computed, O(mn). The used
+    // columns of the panels are always the leading ones.
+    const Eigen::Index used = k + 1;
+
+    physical.head(used).noalias() = S.leftCols(used).transpose() * s;
+    toLogical(used, sv.head(used));
+    SS.row(k).head(used) = sv.head(used).transpose();
+    SS.col(k).head(used) = sv.head(used);
+
+    physical.head(used).noalias() = S.leftCols(used).transpose() * y;
+    toLogical(used, sv.head(used));
+    SY.col(k).head(used) = sv.head(used);
+
+    physical.head(used).noalias() = Y.leftCols(used).transpose() * s;
+    toLogical(used, yv.head(used));
+    SY.row(k).head(used) = yv.head(used).transpose();
+
+    physical.head(used).noalias() = Y.leftCols(used).transpose() * y;
+    toLogical(used, yv.head(used));
+    YY.row(k).head(used) = yv.head(used).transpose();
+    YY.col(k).head(used) = yv.head(used);
+
+    ++numPairs;
+    theta = yyInner / ysInner;
+
+    factorizeMiddle();
+
+    return true;
+}
+
+/*
+ *  Moves the inner products of all but the oldest pair to the upper left.
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::shiftInnerProducts()
+{
+    for (Eigen::Index j = 0; j + 1 < numPairs; ++j)
+    {
+        for (Eigen::Index i = 0; i + 1 < numPairs; ++i)
+        {
+            SS(i, j) = SS(i + 1, j + 1);
+            SY(i, j) = SY(i + 1, j + 1);
+            YY(i, j) = YY(i + 1, j + 1);
+        }
+    }
+}
+
+/*
+ *  Reorders the leading entries of physical, which belong to the columns of the panels, from
+ *  the oldest to the newest pair.
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::toLogical(Eigen::Index size,
+                                  SmallRef     logical) const
+{
+    for (Eigen::Index i = 0; i < size; ++i)
+    {
+        logical(i) = physical(physicalIndex(i));
+    }
+}
+
+/*
+ *  The middle matrix is the inverse of
+ *
+ *      K = [ -D   L^T        ]
+ *          [  L   theta S^T S ],
+ *
+ *  which is factorized as in (3.7) of
+ *  Richard H. Byrd, Peihuang Lu, Jorge Nocedal and Ciyou Zhu, A Limited Memory Algorithm for
+ *  Bound Constrained Optimization, SIAM Journal on Scientific Computing, 16(5), 1995
+ *  through the Cholesky factorization J J^T = theta S^T S + L D^{-1} L^T, which is positive
+ *  definite for s_i^T y_i > 0. The matrices have at most m rows, hence the plain loops.
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::factorizeMiddle()
+{
+    const Eigen::Index k = numPairs;
+
+    for (Eigen::Index i = 0; i < k; ++i)
+    {
+        D(i) = SY(i, i);
+        for (Eigen::Index j = 0; j < k; ++j)
+        {
+            L(i, j) = (i > j) ? SY(i, j) : 0.0;
+        }
+    }
+
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        for (Eigen::Index i = j; i < k; ++i)
+        {
+            double sum = theta * SS(i, j);
+            for (Eigen::Index l = 0; l < j; ++l)
+            {
+                sum += L(i, l) * L(j, l) / D(l);
+            }
+
+            for (Eigen::Index l = 0; l < j; ++l)
+            {
+                sum -= J(i, l) * J(j, l);
+            }
+
+            J(i, j) = (i == j) ? std::sqrt(sum) : sum / J(j, j);
+        }
+    }
+}
+
+/*
+ *  Overwrites p with M p = K^{-1} p by substitution with the block factors of K.
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::solveMiddle(SmallRef p) const
+{
+    const Eigen::Index k = numPairs;
+
+    auto top = p.head(k);
+    auto bottom = p.segment(k, k);
+
+    // bottom = J^{-T} J^{-1} (bottom + L D^{-1} top)
+    for (Eigen::Index i = 1; i < k; ++i)
+    {
+        for (Eigen::Index j = 0; j < i; ++j)
+        {
+            bottom(i) += L(i, j) * top(j) / D(j);
+        }
+    }
+
+    const auto lower = J.topLeftCorner(k, k).template triangularView<Eigen::Lower>();
+    lower.solveInPlace(bottom);
+    lower.transpose().solveInPlace(bottom);
+
+    // top = D^{-1} (L^T bottom - top)
+    for (Eigen::Index i = 0; i < k; ++i)
+    {
+        top(i) = (L.col(i).segment(i + 1, k - i - 1).dot(bottom.tail(k - i - 1)) - top(i)) / D(i);
+    }
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::applyMiddle(const SmallVector & p,
+                                    SmallVector &       result)
+{
+    result = p;
+    solveMiddle(result);
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::applyWTranspose(const Vector & v,
+                                        SmallVector &  result)
+{
+    const Eigen::Index k = numPairs;
+
+    result.resize(2 * k);
+
+    physical.head(k).noalias() = Y.leftCols(k).transpose() * v;
+    toLogical(k, result.head(k));
+    physical.head(k).noalias() = S.leftCols(k).transpose() * v;
+    toLogical(k, result.tail(k));
+
+    result.tail(k) *= theta;
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::applyW(const SmallVector & p,
+                               Vector &            result) const
+{
+    const Eigen::Index k = numPairs;
+
+    result.setZero(S.rows());
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        const Eigen::Index column = physicalIndex(j);
+
+        result += p(j) * Y.col(column);
+        result += (theta * p(k + j)) * S.col(column);
+    }
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::getWRow(Eigen::Index  i,
+                                SmallVector & result) const
+{
+    const Eigen::Index k = numPairs;
+
+    result.resize(2 * k);
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        result(j)     = Y(i, physicalIndex(j));
+        result(k + j) = theta * S(i, physicalIndex(j));
+    }
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::applyHessian(const Vector & v,
+                                     Vector &       result)
+{
+    const Eigen::Index k = numPairs;
+
+    result = theta * v;
+    if (k == 0)
+    {
+        return;
+    }
+
+    // M W^T v
+    physical.head(k).noalias() = Y.leftCols(k).transpose() * v;
+    toLogical(k, small.head(k));
+    physical.head(k).noalias() = S.leftCols(k).transpose() * v;
+    toLogical(k, small.segment(k, k));
+    small.segment(k, k) *= theta;
+
+    solveMiddle(small.head(2 * k));
+
+    // result -= W M W^T v, with the coefficients mapped back to the ring buffer.
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        const Eigen::Index column = physicalIndex(j);
+
+        result -= small(j) * Y.col(column);
+        result -= (theta * small(k + j)) * S.col(column);
+    }
+}
+
+/*
+ *  Implements the compact representation (7.24) of the inverse Hessian from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 182
+ *  with H_0 = I / theta and the upper triangle R of S^T Y.
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::applyInverseHessian(const Vector & v,
+                                            Vector &       result)
+{
+    const Eigen::Index k = numPairs;
+    const double gamma = 1.0 / theta;
+
+    result = gamma * v;
+    if (k == 0)
+    {
+        return;
+    }
+
+    auto q = small.head(k);
+    auto p = smallResult.head(k);
+
+    physical.head(k).noalias() = S.leftCols(k).transpose() * v;
+    toLogical(k, q);
+    physical.head(k).noalias() = Y.leftCols(k).transpose() * v;
+    toLogical(k, yv.head(k));
+
+    const auto R = SY.topLeftCorner(k, k).template triangularView<Eigen::Upper>();
+
+    // q = R^{-1} S^T v
+    R.solveInPlace(q);
+
+    // p = R^{-T} ((D + gamma Y^T Y) q - gamma Y^T v)
+    p.noalias() = YY.topLeftCorner(k, k) * q;
+    p *= gamma;
+    p += D.head(k).cwiseProduct(q);
+    p -= gamma * yv.head(k);
+    R.transpose().solveInPlace(p);
+
+    // result += S p - gamma Y q
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        const Eigen::Index column = physicalIndex(j);
+
+        result += p(j) * S.col(column);
+        result -= (gamma * q(j)) * Y.col(column);
+    }
+}
+
+/*
+ *  Implements (5.11) of
+ *  Richard H. Byrd, Peihuang Lu, Jorge Nocedal and Ciyou Zhu, A Limited Memory Algorithm for
+ *  Bound Constrained Optimization, SIAM Journal on Scientific Computing, 16(5), 1995
+ *
+ *      (Z^T B Z)^{-1} = I / theta + Z^T W (I - M W^T Z Z^T W / theta)^{-1} M W^T Z / theta^2
+ */
+
+template <int Dim>
+void CompactLBFGS<Dim>::solveReduced(const std::vector<Eigen::Index> & indices,
+                                     const SmallVector &               rhs,
+                                     SmallVector &                     result)
+{
+    const Eigen::Index k = numPairs;
+    const Eigen::Index numIndices = static_cast<Eigen::Index>(indices.size());
+
+    result = rhs / theta;
+    if (k == 0 || numIndices == 0)
+    {
+        return;
+    }
+
+    // Rows of W belonging to the indices.
+    reducedW.resize(numIndices, 2 * k);
+    for (Eigen::Index j = 0; j < k; ++j)
+    {
+        const Eigen::Index column = physicalIndex(j);
+
+        for (Eigen::Index i = 0; i < numIndices; ++i)
+        {
+            reducedW(i, j)     = Y(indices[i], column);
+            reducedW(i, k + j) = theta * S(indices[i], column);
+        }
+    }
+
+    // N = I - M W^T Z Z^T W / theta
+    reducedN.resize(2 * k, 2 * k);
+    reducedN.noalias() = reducedW.transpose() * reducedW;
+    for (Eigen::Index j = 0; j < 2 * k; ++j)
+    {
+        solveMiddle(reducedN.col(j));
+    }
+    reducedN /= -theta;
+    reducedN.diagonal().array() += 1.0;
+    reducedLU.compute(reducedN);
+
+    auto product = small.head(2 * k);
+
+    product.noalias() = reducedW.transpose() * rhs;
+    solveMiddle(product);
+    product = reducedLU.solve(product).eval();
+
+    result.noalias() += reducedW * (product / (theta * theta));
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::setMemory(unsigned int memory)
+{
+    if (memory == 0)
+    {
+        throw std::invalid_argument("Memory must be greater than zero.");
+    }
+
+    this->memory = memory;
+
+    reset(S.rows());
+}
+
+template <int Dim>
+unsigned int CompactLBFGS<Dim>::getMemory() const
+{
+    return memory;
+}
+
+template <int Dim>
+void CompactLBFGS<Dim>::setSkipTol(double skipTol)
+{
+    if (skipTol < 0.0 || skipTol >= 1.0)
+    {
+        throw std::invalid_argument("Skip tolerance must be in [0, 1).");
+    }
+
+    this->skipTol = skipTol;
+}
+
+template <int Dim>
+double CompactLBFGS<Dim>::getSkipTol() const
+{
+    return skipTol;
+}
+
+extern template class CompactLBFGS<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/Callable.hpp>
+#include <Optimization/Function.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Composite objective function F(x) = f(x) + h(x) of a smooth function f, given as a
+ *  Function, and a convex, possibly non-smooth function h, e.g. lambda ||x||_1 or the
+ *  indicator of a box. The function h enters only through its proximal operator
+ *
+ *      prox(point, stepLength) = argmin_z h(z) + ||z - point||^2 / (2 stepLength),
+ *
+ *  a callable called as proxFunc(point, stepLength, proxValue). The optional callable
+ *  regFunc(parameters, regValue) evaluates h for the reported objective function value;
+ *  without it h is taken as zero there. See L1Norm and BoxIndicator for common choices.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class CompositeFunction
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1>                                                Vector;
+        typedef Callable<void (const Vector & point, double stepLength, Vector & proxValue)> Proximal;
+        typedef Callable<void (const Vector & parameters, double & regValue)>                Regularizer;
+
+    public:
+        CompositeFunction(Function<Dim> & smoothFunc,
+                          Proximal        proxFunc,
+                          Regularizer     regFunc = nullptr);
+
+        inline Function<Dim> & getSmoothFunction()
+        {
+            return *smoothFunc;
+        }
+
+        inline void calcProx(const Vector & point,
+                             double         stepLength,
+                             Vector &       proxValue)
+        {
+            proxFunc(point, stepLength, proxValue);
+        }
+
+        inline double calcRegValue(const Vector & parameters)
+        {
+            double regValue = 0.0;
+
+            if (regFunc)
+            {
+                regFunc(parameters, regValue);
+            }
+
+            return regValue;
+        }
+
+    private:
+        Function<Dim> * smoothFunc;
+        Proximal        proxFunc;
+        Regularizer     regFunc;
+};
+
+/*
+ *  h(x) = lambda ||x||_1, whose proximal operator is the soft thresholding at
+ *  lambda * stepLength. It serves both as proximal operator and as regularizer.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class L1Norm
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        L1Norm(double lambda)
+        {
+            if (lambda < 0.0)
+            {
+                throw std::invalid_argument("The weight of the L1 norm must be greater than or equal to zero.");
+            }
+
+            this->lambda = lambda;
+        }
+
+        inline void operator()(const Vector & point,
+                               double         stepLength,
+                               Vector &       proxValue) const
+        {
+            const double threshold = lambda * stepLength;
+
+            proxValue = point.array().sign() * (point.array().abs() - threshold).max(0.0);
+        }
+
+        inline void operator()(const Vector & parameters,
+                               double &       regValue) const
+        {
+            regValue = lambda * parameters.template lpNorm<1>();
+        }
+
+    private:
+        double lambda;
+};
+
+/*
+ *  Indicator of the box lowerBounds <= x <= upperBounds, whose proximal operator is the
+ *  projection onto the box. The bounds are referenced, not copied, and must outlive it.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class BoxIndicator
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        BoxIndicator(const Vector & lowerBounds,
+                     const Vector & upperBounds)
+                     :
+                     lowerBounds(&lowerBounds),
+                     upperBounds(&upperBounds)
+        {
+            if (lowerBounds.size() != upperBounds.size() || (lowerBounds.array() > upperBounds.array()).any())
+            {
+                throw std::invalid_argument("Lower bounds must be less than or equal to upper bounds.");
+            }
+        }
+
+        inline void operator()(const Vector & point,
+                               double         stepLength,
+                               Vector &       proxValue) const
+        {
+            proxValue = point.cwiseMax(*lowerBounds).cwiseMin(*upperBounds);
+        }
+
+        inline void operator()(const Vector & parameters,
+                               double &       regValue) const
+        {
+            const bool inside = (parameters.array() >= lowerBounds->array()).all() &&
+                                (parameters.array() <= upperBounds->array()).all();
+
+            regValue = inside ? 0.0 : INFINITY;
+        }
+
+    private:
+        const Vector * lowerBounds;
+        const Vector * upperBounds;
+};
+
+template <int Dim>
+CompositeFunction<Dim>::CompositeFunction(Function<Dim> & smoothFunc,
+                                          Proximal        proxFunc,
+                                          Regularizer     regFunc)
+                                          :
+                                          smoothFunc(&smoothFunc),
+                                          proxFunc(proxFunc),
+                                          regFunc(regFunc)
+{
+    if (!this->proxFunc)
+    {
+        throw std::invalid_argument("The proximal operator must not be empty.");
+    }
+}
+
+extern template class CompositeFunction<Eigen::Dynamic>;
+
+}
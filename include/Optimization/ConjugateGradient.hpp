@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+
+#include <Optimization/BaseAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Direction policy for StaticSolver.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class ConjugateGradientPolicy
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction)
+        {
+            direction = -1 * gradient;
+        }
+
+        void updateDirection(const Vector & parameters,
+                             const Vector & gradient,
+                             const Vector & lastParameters,
+                             const Vector & lastGradient,
+                             Vector &       direction);
+};
+
+/*
+ *  Nonlinear conjugate gradient method. With the exact line search of a QuadraticFunction it
+ *  is the linear conjugate gradient method, which converges in at most n iterations for a
+ *  positive definite matrix.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class ConjugateGradient : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector Vector;
+
+    public:
+        ConjugateGradient(Function<Dim> &               objFunc,
+                          const Vector &                initialParameters,
+                          double                        gradTol = 1e-9,
+                          double                        relTol = 1e-9,
+                          unsigned int                  maxNumIterations = 100000,
+                          typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        ~ConjugateGradient();
+
+    private:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
+    private:
+        ConjugateGradientPolicy<Dim> policy;
+};
+
+/*
+ *  Implements the Polak-Ribiere+ update (5.45) from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 122
+ *
+ *  For a quadratic function with exact line searches the gradients are mutually orthogonal,
+ *  hence the update coincides with the one of the linear conjugate gradient Algorithm 5.2.
+ */
+
+template <int Dim>
+void ConjugateGradientPolicy<Dim>::updateDirection(const Vector & parameters,
+                                                   const Vector & gradient,
+                                                   const Vector & lastParameters,
+                                                   const Vector & lastGradient,
+                                                   Vector &       direction)
+{
+    const double lastGradNormSquared = lastGradient.squaredNorm();
+    const double beta = std::max(0.0, (gradient.squaredNorm() - gradient.dot(lastGradient)) / lastGradNormSquared);
+
+    direction = beta * direction - gradient;
+
+    // Restart with the steepest descent direction if the update is no descent direction.
+    if (0 <= gradient.dot(direction))
+    {
+        direction = -1 * gradient;
+    }
+}
+
+template <int Dim>
+ConjugateGradient<Dim>::ConjugateGradient(Function<Dim> &               objFunc,
+                                          const Vector &                initialParameters,
+                                          double                        gradTol,
+                                          double                        relTol,
+                                          unsigned int                  maxNumIterations,
+                                          typename LineSearch<Dim>::Ptr lineSearch)
+                                          :
+                                          BaseAlgorithm<Dim>(objFunc,
+                                                             initialParameters,
+                                                             gradTol,
+                                                             relTol,
+                                                             maxNumIterations,
+                                                             lineSearch)
+{
+
+}
+
+template <int Dim>
+ConjugateGradient<Dim>::~ConjugateGradient()
+{
+
+}
+
+extern template class ConjugateGradientPolicy<Eigen::Dynamic>;
+extern template class ConjugateGradient<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include <Optimization/CompositeFunction.hpp>
+#include <Optimization/Result.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Accelerated proximal gradient method (FISTA) for composite objective functions
+ *  F(x) = f(x) + h(x), see CompositeFunction. Every iteration takes a proximal gradient step
+ *  with step length 1 / L from an extrapolated point y,
+ *
+ *      x_{k+1} = prox(y - grad f(y) / L, 1 / L),
+ *
+ *  where the estimate L of the Lipschitz constant of grad f is doubled until the quadratic
+ *  upper bound of f holds at x_{k+1}, and shrunk by a factor before each iteration, see
+ *  setLipschitzDecrease, so it follows the local curvature. The momentum is restarted whenever
+ *  the step x_{k+1} - x_k and the gradient mapping G = L (y - x_{k+1}) form an acute angle,
+ *  which keeps the accelerated method monotone in practice and recovers linear convergence on
+ *  strongly convex problems. Apart from the callables, an iteration costs O(n).
+ *
+ *  The gradient tolerance applies to the infinity norm of the gradient mapping, which equals
+ *  the gradient if h is zero and is reported as the gradient norm of the result. The reported
+ *  function value includes h if the CompositeFunction can evaluate it.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class FISTA
+{
+    public:
+        typedef typename CompositeFunction<Dim>::Vector Vector;
+
+    public:
+        FISTA(CompositeFunction<Dim> & objFunc,
+              const Vector &           initialParameters,
+              double                   gradTol = 1e-9,
+              double                   relTol = 1e-9,
+              unsigned int             maxNumIterations = 100000);
+
+        ~FISTA();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        unsigned int getNumIterations() const;
+
+        /*
+         *  Number of momentum restarts during the last solve.
+         */
+
+        unsigned int getNumRestarts() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  Initial estimate of the Lipschitz constant of the gradient of the smooth part. The
+         *  default value is 1.
+         */
+
+        void setInitialLipschitz(double initialLipschitz);
+        double getInitialLipschitz() const;
+
+        /*
+         *  Factor in (0, 1] the Lipschitz estimate is multiplied by before each iteration. One
+         *  gives the monotone estimate of the original method. The default value is 0.9.
+         */
+
+        void setLipschitzDecrease(double lipschitzDecrease);
+        double getLipschitzDecrease() const;
+
+        /*
+         *  Turns the adaptive restart of the momentum on or off. It is on by default.
+         */
+
+        void setRestart(bool restart);
+        bool getRestart() const;
+
+    private:
+        static constexpr double maxLipschitz = 1e30;
+
+        Vector                   initialParameters;
+
+        double                   gradTol;
+        double                   relTol;
+        unsigned int             numIterations;
+        unsigned int             numRestarts;
+        unsigned int             maxNumIterations;
+        double                   initialLipschitz;
+        double                   lipschitzDecrease;
+        bool                     restart;
+
+        Vector                   parameters;
+        Vector                   trialParameters;
+        Vector                   extrapolatedPoint;
+        Vector                   gradient;
+        Vector                   gradientStep;
+
+        CompositeFunction<Dim> * objFunc;
+};
+
+template <int Dim>
+FISTA<Dim>::FISTA(CompositeFunction<Dim> & objFunc,
+                  const Vector &           initialParameters,
+                  double                   gradTol,
+                  double                   relTol,
+                  unsigned int             maxNumIterations)
+{
+    setInitialParameters(initialParameters);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    numRestarts = 0;
+    setMaxNumIterations(maxNumIterations);
+
+    setInitialLipschitz(1.0);
+    setLipschitzDecrease(0.9);
+    setRestart(true);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+FISTA<Dim>::~FISTA()
+{
+
+}
+
+/*
+ *  Implements FISTA with backtracking of
+ *  Amir Beck and Marc Teboulle, A Fast Iterative Shrinkage-Thresholding Algorithm for Linear
+ *  Inverse Problems, SIAM Journal on Imaging Sciences, 2(1), 2009
+ *  with the momentum update for a decreasing Lipschitz estimate of
+ *  Katya Scheinberg, Donald Goldfarb and Xi Bai, Fast First-Order Methods for Composite Convex
+ *  Optimization with Backtracking, Foundations of Computational Mathematics, 14(3), 2014
+ *  and the gradient restart scheme of
+ *  Brendan O'Donoghue and Emmanuel Candes, Adaptive Restart for Accelerated Gradient Schemes,
+ *  Foundations of Computational Mathematics, 15(3), 2015.
+ */
+
+template <int Dim>
+void FISTA<Dim>::solve(Result & result)
+{
+    Function<Dim> & smoothFunc = objFunc->getSmoothFunction();
+
+    double funcValue;
+    double extrapolatedFuncValue;
+    double trialFuncValue;
+    double gradMapNorm = INFINITY;
+
+    // Start from a point in the domain of h.
+    objFunc->calcProx(initialParameters, 0.0, parameters);
+    extrapolatedPoint = parameters;
+    gradient.resize(parameters.size());
+
+    numIterations = 0;
+    numRestarts = 0;
+
+    // Reset counters of function and gradient evaluations.
+    smoothFunc.resetNumEvaluations();
+
+    smoothFunc.calcObjFuncValue(parameters, funcValue);
+    double totalFuncValue = funcValue + objFunc->calcRegValue(parameters);
+
+    double lipschitz = initialLipschitz;
+    double momentum = 1.0;
+    bool extrapolated = false;
+
+    while (true)
+    {
+        ++numIterations;
+
+        // The function value at the extrapolated point is known if it equals the parameters.
+        if (!extrapolated)
+        {
+            extrapolatedFuncValue = funcValue;
+        }
+        else
+        {
+            smoothFunc.calcObjFuncValue(extrapolatedPoint, extrapolatedFuncValue);
+        }
+        smoothFunc.calcGrad(extrapolatedPoint, gradient);
+
+        // Backtracking on the Lipschitz estimate until the quadratic upper bound holds.
+        double trialLipschitz = lipschitz * lipschitzDecrease;
+        while (true)
+        {
+            gradientStep = extrapolatedPoint - gradient / trialLipschitz;
+            objFunc->calcProx(gradientStep, 1.0 / trialLipschitz, trialParameters);
+            gradientStep = trialParameters - extrapolatedPoint;
+
+            smoothFunc.calcObjFuncValue(trialParameters, trialFuncValue);
+
+            const double upperBound = extrapolatedFuncValue + gradient.dot(gradientStep) +
+                                      0.5 * trialLipschitz * gradientStep.squaredNorm();
+
+            // A step at the resolution of the parameters is accepted to avoid chasing round-off.
+            if (trialFuncValue <= upperBound ||
+                gradientStep.template lpNorm<Eigen::Infinity>() <= DBL_EPSILON * std::max(1.0, extrapolatedPoint.template lpNorm<Eigen::Infinity>()))
+            {
+                break;
+            }
+
+            trialLipschitz *= 2.0;
+            if (trialLipschitz > maxLipschitz)
+            {
+                result.set(LineSearchFailed, parameters, totalFuncValue, gradMapNorm, numIterations,
+                           smoothFunc.getNumFuncEvaluations(), smoothFunc.getNumGradEvaluations());
+                return;
+            }
+        }
+
+        gradMapNorm = trialLipschitz * gradientStep.template lpNorm<Eigen::Infinity>();
+
+        const double nextMomentum = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * (trialLipschitz / lipschitz) * momentum * momentum));
+        lipschitz = trialLipschitz;
+
+        // gradientStep becomes the step x_{k+1} - x_k, extrapolatedPoint the next one.
+        const double restartIndicator = -gradientStep.dot(trialParameters - parameters);
+        gradientStep = trialParameters - parameters;
+        parameters.swap(trialParameters);
+
+        if (restart && restartIndicator > 0.0)
+        {
+            ++numRestarts;
+            momentum = 1.0;
+            extrapolatedPoint = parameters;
+            extrapolated = false;
+        }
+        else
+        {
+            extrapolatedPoint = parameters + ((momentum - 1.0) / nextMomentum) * gradientStep;
+            extrapolated = (momentum != 1.0);
+            momentum = nextMomentum;
+        }
+
+        const double lastTotalFuncValue = totalFuncValue;
+        funcValue = trialFuncValue;
+        totalFuncValue = funcValue + objFunc->calcRegValue(parameters);
+
+        // Gradient convergence test.
+        if (gradMapNorm <= gradTol)
+        {
+            result.set(Gradient, parameters, totalFuncValue, gradMapNorm, numIterations,
+                       smoothFunc.getNumFuncEvaluations(), smoothFunc.getNumGradEvaluations());
+            return;
+        }
+
+        // Relative convergence test.
+        if (std::fabs(lastTotalFuncValue - totalFuncValue) <= relTol * std::fabs(totalFuncValue))
+        {
+            result.set(Relative, parameters, totalFuncValue, gradMapNorm, numIterations,
+                       smoothFunc.getNumFuncEvaluations(), smoothFunc.getNumGradEvaluations());
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, parameters, totalFuncValue, gradMapNorm, numIterations,
+                       smoothFunc.getNumFuncEvaluations(), smoothFunc.getNumGradEvaluations());
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void FISTA<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename FISTA<Dim>::Vector & FISTA<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+unsigned int FISTA<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+unsigned int FISTA<Dim>::getNumRestarts() const
+{
+    return numRestarts;
+}
+
+template <int Dim>
+void FISTA<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int FISTA<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+void FISTA<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double FISTA<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void FISTA<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double FISTA<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+template <int Dim>
+void FISTA<Dim>::setInitialLipschitz(double initialLipschitz)
+{
+    if (initialLipschitz <= 0.0)
+    {
+        throw std::invalid_argument("Initial Lipschitz estimate must be greater than zero.");
+    }
+    this->initialLipschitz = initialLipschitz;
+}
+
+template <int Dim>
+double FISTA<Dim>::getInitialLipschitz() const
+{
+    return initialLipschitz;
+}
+
+template <int Dim>
+void FISTA<Dim>::setLipschitzDecrease(double lipschitzDecrease)
+{
+    if (lipschitzDecrease <= 0.0 || lipschitzDecrease > 1.0)
+    {
+        throw std::invalid_argument("Lipschitz decrease factor must be in (0, 1].");
+    }
+    this->lipschitzDecrease = lipschitzDecrease;
+}
+
+template <int Dim>
+double FISTA<Dim>::getLipschitzDecrease() const
+{
+    return lipschitzDecrease;
+}
+
+template <int Dim>
+void FISTA<Dim>::setRestart(bool restart)
+{
+    this->restart = restart;
+}
+
+template <int Dim>
+bool FISTA<Dim>::getRestart() const
+{
+    return restart;
+}
+
+extern template class FISTA<Eigen::Dynamic>;
+
+}
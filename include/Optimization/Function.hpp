@@ -1,37 +1,214 @@
 #pragma once
 
 #include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <Eigen/Dense>
+#include <Optimization/Callable.hpp>
+#include <Optimization/ThreadPool.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class Function 
+/*
+ *  Marks an objective function without an analytic gradient. The gradient is then
+ *  approximated with forward differences.
+ */
+
+struct NoGradient { };
+
+/*
+ *  Marks an objective function without a batched evaluation. The points of a batch are
+ *  then evaluated one by one.
+ */
+
+struct NoBatch { };
+
+/*
+ *  Marks an objective function without an analytic Hessian. The Hessian is then approximated
+ *  with forward differences of the gradient, or of the function values without a gradient.
+ */
+
+struct NoHessian { };
+
+/*
+ *  The template parameter Dim is the number of parameters of the objective function.
+ *  When it is known at compile time, all vectors are fixed-size and stack-resident,
+ *  which lets Eigen unroll the kernels for small problems. The default, Eigen::Dynamic,
+ *  keeps the number of parameters a runtime quantity.
+ *
+ *  ValueFunc and GradientFunc are the types of the callables evaluating the objective
+ *  function and its gradient. They are called as objFunc(parameters, objFuncValue) and
+ *  gradFunc(parameters, gradValue). When they are functor types, e.g. lambdas, the calls
+ *  can be inlined into the solvers of StaticSolver.hpp.
+ *
+ *  BatchFunc is the type of an optional callable evaluating several points at once. It is
+ *  called as batchFunc(points, objFuncValues), where the columns of points are the points
+ *  and objFuncValues is already sized to their number. It lets the user vectorize across
+ *  points or hand the whole batch to an external simulator.
+ *
+ *  HessianFunc is the type of an optional callable evaluating the Hessian matrix. It is
+ *  called as hessFunc(parameters, hessValue), where hessValue is already sized.
+ *
+ *  The parallel paths, LineSearchParallel and a thread pool given with setThreadPool, call
+ *  the callables concurrently on copies of the function. The callables must then be
+ *  reentrant: state captured by reference or pointer is shared by all copies and may only
+ *  be read, scratch buffers have to be local or owned by each copy.
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc = NoGradient, class BatchFunc = NoBatch, class HessianFunc = NoHessian>
+class BasicFunction
 {
     public:
-        typedef void (* Value)(const Eigen::VectorXd & parameters, double & objFuncValue);
-        typedef void (* Gradient)(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradValue);
+        typedef Eigen::Matrix<double, Dim, 1>              Vector;
+        typedef Eigen::Matrix<double, Dim, Eigen::Dynamic> Points;
+        typedef Eigen::Matrix<double, Dim, Dim>            Matrix;
+
+        typedef ValueFunc    Value;
+        typedef GradientFunc Gradient;
+        typedef BatchFunc    Batch;
+        typedef HessianFunc  Hessian;
 
     public:
-        Function(Value objFunc, Gradient gradFunc = nullptr);
-        
-        virtual ~Function() { }
+        BasicFunction(Value objFunc, Gradient gradFunc = Gradient(), Batch batchFunc = Batch(), Hessian hessFunc = Hessian());
 
-        void calcObjFuncValue(const Eigen::VectorXd & parameters,
-                              double & objFuncValue);
+        virtual ~BasicFunction() { }
 
-        inline void calcGrad(const Eigen::VectorXd & parameters,
-                             Eigen::VectorXd &       gradValue)
+        void calcObjFuncValue(const Vector & parameters,
+                              double &       objFuncValue);
+
+        /*
+         *  Evaluates the objective function at each column of points. The batched callable is
+         *  used when it is given, otherwise the points are evaluated one by one.
+         */
+
+        void calcObjFuncValues(const Points &    points,
+                               Eigen::VectorXd & objFuncValues);
+
+        inline void calcGrad(const Vector & parameters,
+                             Vector &       gradValue)
         {
-            if (this->gradFunc == nullptr)
+            if (hasGradient() && measureCost)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                calcExactGrad(parameters, gradValue);
+                gradTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            else if (hasGradient())
+            {
+                calcExactGrad(parameters, gradValue);
+            }
+            else
             {
                 calcApproxGrad(parameters, gradValue);
             }
+        }
+
+        /*
+         *  Computes the Hessian matrix, sized to the number of parameters. Without a Hessian
+         *  callable, it is approximated, see calcApproxHessian.
+         */
+
+        inline void calcHessian(const Vector & parameters,
+                                Matrix &       hessValue)
+        {
+            if (hasHessian())
+            {
+                hessValue.resize(parameters.size(), parameters.size());
+                calcExactHessian(parameters, hessValue);
+            }
             else
             {
-                calcExactGrad(parameters, gradValue);
+                calcApproxHessian(parameters, hessValue);
+            }
+        }
+
+        /*
+         *  Approximates the Hessian matrix, sized to the number of parameters, with forward
+         *  differences of the gradient, which costs n + 1 gradient evaluations, or of the
+         *  function values without a gradient, which costs (n + 1) (n + 2) / 2 function
+         *  evaluations. The result is symmetric. Given a batch callable, the function values are
+         *  evaluated in batches, see calcObjFuncValues.
+         *
+         *  With a thread pool, see setThreadPool, the evaluations are distributed across its
+         *  threads. Each thread calls its own copy of the callables, hence they must be safe
+         *  to call concurrently from copies. The result equals the one of the serial
+         *  approximation.
+         */
+
+        void calcApproxHessian(const Vector & parameters,
+                               Matrix &       hessValue);
+
+        /*
+         *  The thread pool approximating the Hessian. By default there is none and the
+         *  Hessian is approximated on the calling thread.
+         */
+
+        inline void setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+        {
+            this->threadPool = threadPool;
+        }
+
+        inline std::shared_ptr<ThreadPool> getThreadPool() const
+        {
+            return threadPool;
+        }
+
+        /*
+         *  Approximates the derivative of the objective function at parameters along
+         *  direction with a forward difference, given the function value at parameters.
+         *  It costs a single function evaluation instead of the n + 1 evaluations of the
+         *  approximate gradient, hence the line searches use it for their curvature tests
+         *  when no exact gradient is given. It is zero without an evaluation for a zero
+         *  direction.
+         */
+
+        double calcDirectionalDerivative(const Vector & parameters,
+                                         double         funcValue,
+                                         const Vector & direction);
+
+        /*
+         *  Whether the gradient is computed by the given callable rather than approximated.
+         */
+
+        inline bool hasGradient() const
+        {
+            if constexpr (std::is_same<Gradient, NoGradient>::value)
+            {
+                return false;
+            }
+            else if constexpr (std::is_constructible<bool, const Gradient &>::value)
+            {
+                return static_cast<bool>(this->gradFunc);
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        /*
+         *  Whether the Hessian is computed by the given callable rather than approximated.
+         */
+
+        inline bool hasHessian() const
+        {
+            if constexpr (std::is_same<Hessian, NoHessian>::value)
+            {
+                return false;
+            }
+            else if constexpr (std::is_constructible<bool, const Hessian &>::value)
+            {
+                return static_cast<bool>(this->hessFunc);
+            }
+            else
+            {
+                return true;
             }
         }
 
@@ -45,24 +222,619 @@ class Function
             return numGradEvaluations;
         }
 
+        inline unsigned int getNumHessEvaluations() const
+        {
+            return numHessEvaluations;
+        }
+
         inline void resetNumEvaluations()
         {
             numFuncEvaluations = 0;
             numGradEvaluations = 0;
+            numHessEvaluations = 0;
+            funcTime           = 0.0;
+            gradTime           = 0.0;
+        }
+
+        /*
+         *  Enables measuring the wall time of the callables, which costs two clock reads per
+         *  call. The mean costs since the last reset are used to choose between strategies of
+         *  different evaluation patterns, e.g. by LineSearchAdaptive. An approximate gradient
+         *  is accounted for by the function evaluations it consists of.
+         */
+
+        inline void setMeasureCost(bool measureCost)
+        {
+            this->measureCost = measureCost;
+        }
+
+        inline bool getMeasureCost() const
+        {
+            return measureCost;
+        }
+
+        /*
+         *  Mean wall time of a function evaluation in seconds, zero if none was measured.
+         */
+
+        inline double getFuncEvaluationCost() const
+        {
+            return numFuncEvaluations > 0 ? funcTime / numFuncEvaluations : 0.0;
+        }
+
+        /*
+         *  Mean wall time of an exact gradient evaluation in seconds, zero if none was measured.
+         */
+
+        inline double getGradEvaluationCost() const
+        {
+            return numGradEvaluations > 0 ? gradTime / numGradEvaluations : 0.0;
+        }
+
+        /*
+         *  Accounts for evaluations carried out on copies of this function, e.g. by the
+         *  threads of a parallel line search, or by callables held outside of it, e.g. the
+         *  sparse Hessian of SparseNewton.
+         */
+
+        inline void addNumEvaluations(unsigned int numFuncEvaluations,
+                                      unsigned int numGradEvaluations,
+                                      unsigned int numHessEvaluations = 0)
+        {
+            this->numFuncEvaluations += numFuncEvaluations;
+            this->numGradEvaluations += numGradEvaluations;
+            this->numHessEvaluations += numHessEvaluations;
         }
 
     private:
-        void calcExactGrad(const Eigen::VectorXd & parameters,
-                           Eigen::VectorXd &       gradValue);
+        inline bool hasBatch() const
+        {
+            if constexpr (std::is_same<Batch, NoBatch>::value)
+            {
+                return false;
+            }
+            else if constexpr (std::is_constructible<bool, const Batch &>::value)
+            {
+                return static_cast<bool>(this->batchFunc);
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        void calcExactGrad(const Vector & parameters,
+                           Vector &       gradValue);
+
+        void calcApproxGrad(const Vector & parameters,
+                            Vector &       gradValue);
+
+        void calcExactHessian(const Vector & parameters,
+                              Matrix &       hessValue);
+
+        void calcApproxHessianColumns(unsigned int   thread,
+                                      const Vector & parameters,
+                                      Matrix &       hessValue);
+
+        void calcApproxHessianFuncValues(unsigned int   thread,
+                                         const Vector & parameters);
+
+        void calcApproxHessianRows(unsigned int   thread,
+                                   const Vector & parameters,
+                                   double         funcValue,
+                                   Matrix &       hessValue);
+
+        void calcApproxHessianBatches(const Vector & parameters,
+                                      Matrix &       hessValue);
+
+        inline bool hasParallelHessian() const
+        {
+            return threadPool && threadPool->getNumThreads() > 1;
+        }
 
-        void calcApproxGrad(const Eigen::VectorXd & parameters,
-                            Eigen::VectorXd &       gradValue);
-    
     private:
         Value objFunc;
         Gradient gradFunc;
+        Batch batchFunc;
+        Hessian hessFunc;
         unsigned int numFuncEvaluations;
         unsigned int numGradEvaluations;
+        unsigned int numHessEvaluations;
+
+        bool measureCost;
+        double funcTime;
+        double gradTime;
+
+        Vector gradParameters;
+        Points gradPoints;
+        Eigen::VectorXd gradFuncValues;
+
+        Vector hessParameters;
+        Vector hessGradient;
+        Vector hessForwardGradient;
+        Eigen::VectorXd hessFuncValues;
+
+        std::shared_ptr<ThreadPool> threadPool;
+        std::vector<Vector> hessThreadParameters;
+        std::vector<Vector> hessThreadGradients;
 };
 
+/*
+ *  The objective function given by type-erased callables. Besides plain function pointers,
+ *  they accept functors and lambdas carrying their own problem data, so differently
+ *  parameterized problems need no global state. The callables are stored in a small buffer
+ *  and never allocate, see Callable.hpp. An empty gradient or Hessian selects the forward
+ *  difference approximation and an empty batch the evaluation point by point.
+ */
+
+template <int Dim = Eigen::Dynamic>
+using Function = BasicFunction<Dim,
+                               Callable<void (const Eigen::Matrix<double, Dim, 1> & parameters, double & objFuncValue)>,
+                               Callable<void (const Eigen::Matrix<double, Dim, 1> & parameters, Eigen::Matrix<double, Dim, 1> & gradValue)>,
+                               Callable<void (const Eigen::Matrix<double, Dim, Eigen::Dynamic> & points, Eigen::VectorXd & objFuncValues)>,
+                               Callable<void (const Eigen::Matrix<double, Dim, 1> & parameters, Eigen::Matrix<double, Dim, Dim> & hessValue)>>;
+
+/*
+ *  Creates an objective function from arbitrary callables, deducing their types.
+ */
+
+template <int Dim = Eigen::Dynamic, class ValueFunc, class GradientFunc = NoGradient, class BatchFunc = NoBatch, class HessianFunc = NoHessian>
+inline BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc> makeFunction(ValueFunc    objFunc,
+                                                                                        GradientFunc gradFunc = GradientFunc(),
+                                                                                        BatchFunc    batchFunc = BatchFunc(),
+                                                                                        HessianFunc  hessFunc = HessianFunc())
+{
+    return BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>(objFunc, gradFunc, batchFunc, hessFunc);
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::BasicFunction(Value objFunc, Gradient gradFunc, Batch batchFunc, Hessian hessFunc)
+:
+objFunc(objFunc),
+gradFunc(gradFunc),
+batchFunc(batchFunc),
+hessFunc(hessFunc)
+{
+    numFuncEvaluations = 0;
+    numGradEvaluations = 0;
+    numHessEvaluations = 0;
+
+    measureCost = false;
+    funcTime    = 0.0;
+    gradTime    = 0.0;
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcObjFuncValue(const Vector & parameters,
+                                                                                           double &       objFuncValue)
+{
+    numFuncEvaluations++;
+
+    if (measureCost)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        objFunc(parameters, objFuncValue);
+        funcTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    else
+    {
+        objFunc(parameters, objFuncValue);
+    }
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcObjFuncValues(const Points &    points,
+                                                                                            Eigen::VectorXd & objFuncValues)
+{
+    const Eigen::Index numPoints = points.cols();
+    objFuncValues.resize(numPoints);
+
+    if constexpr (!std::is_same<Batch, NoBatch>::value)
+    {
+        if (hasBatch())
+        {
+            numFuncEvaluations += numPoints;
+
+            if (measureCost)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                batchFunc(points, objFuncValues);
+                funcTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            else
+            {
+                batchFunc(points, objFuncValues);
+            }
+            return;
+        }
+    }
+
+    for (Eigen::Index j = 0; j < numPoints; ++j)
+    {
+        gradParameters = points.col(j);
+        calcObjFuncValue(gradParameters, objFuncValues(j));
+    }
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcExactGrad(const Vector & parameters,
+                                                                                        Vector &       gradValue)
+{
+    if constexpr (!std::is_same<Gradient, NoGradient>::value)
+    {
+        numGradEvaluations++;
+        gradFunc(parameters, gradValue);
+    }
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+double BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcDirectionalDerivative(const Vector & parameters,
+                                                                                                     double         funcValue,
+                                                                                                     const Vector & direction)
+{
+    const double directionNorm = direction.norm();
+
+    // The derivative along a zero direction vanishes, and the step below would be infinite.
+    if (directionNorm == 0.0)
+    {
+        return 0.0;
+    }
+
+    // Scale the step so that the perturbation is as large as the one of calcApproxGrad.
+    const double epsilon = std::sqrt(DBL_EPSILON) / directionNorm;
+
+    double forwardFuncValue;
+    gradParameters = parameters + epsilon * direction;
+    calcObjFuncValue(gradParameters, forwardFuncValue);
+
+    return (forwardFuncValue - funcValue) / epsilon;
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxGrad(const Vector & parameters,
+                                                                                         Vector &       gradValue)
+{
+    const Eigen::Index numParameters = parameters.size();
+    const double epsilon = std::sqrt(DBL_EPSILON);
+    const double invEpsilon = 1.0 / epsilon;
+
+    if (hasBatch())
+    {
+        // All perturbed points are known up front, hence they are evaluated as one batch.
+        // The first column is the unperturbed point.
+        gradPoints.resize(numParameters, numParameters + 1);
+        gradPoints.colwise() = parameters;
+        gradPoints.rightCols(numParameters).diagonal().array() += epsilon;
+
+        calcObjFuncValues(gradPoints, gradFuncValues);
+
+        gradValue = (gradFuncValues.tail(numParameters).array() - gradFuncValues(0)) * invEpsilon;
+
+        return;
+    }
+
+    // The perturbed parameters are kept between calls to avoid an allocation per gradient.
+    gradParameters = parameters;
+
+    double funcValue;
+    double forwardFuncValue;
+    calcObjFuncValue(parameters, funcValue);
+
+    for (Eigen::Index i = 0;  i < numParameters; ++i)
+    {
+        // Compute gradient with forward difference.
+        gradParameters(i) += epsilon;
+        calcObjFuncValue(gradParameters, forwardFuncValue);
+        gradValue(i) = (forwardFuncValue - funcValue) * invEpsilon;
+
+        // Restore original parameter.
+        gradParameters(i) = parameters(i);
+    }
+}
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcExactHessian(const Vector & parameters,
+                                                                                           Matrix &       hessValue)
+{
+    if constexpr (!std::is_same<Hessian, NoHessian>::value)
+    {
+        numHessEvaluations++;
+        hessFunc(parameters, hessValue);
+    }
+}
+
+/*
+ *  Implements the forward difference approximations (8.7) and (8.21) from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Pages 197 and 201
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxHessian(const Vector & parameters,
+                                                                                            Matrix &       hessValue)
+{
+    const Eigen::Index numParameters = parameters.size();
+
+    hessValue.resize(numParameters, numParameters);
+    hessParameters = parameters;
+
+    if (hasParallelHessian())
+    {
+        // Every thread perturbs its own copy of the parameters.
+        const unsigned int numThreads = threadPool->getNumThreads();
+        hessThreadParameters.resize(numThreads);
+        hessThreadGradients.resize(numThreads);
+        for (unsigned int thread = 0; thread < numThreads; ++thread)
+        {
+            hessThreadParameters[thread] = parameters;
+            hessThreadGradients[thread].resize(numParameters);
+        }
+    }
+
+    if (hasGradient())
+    {
+        const double epsilon = std::sqrt(DBL_EPSILON);
+
+        hessGradient.resize(numParameters);
+        hessForwardGradient.resize(numParameters);
+        calcGrad(parameters, hessGradient);
+
+        if (hasParallelHessian())
+        {
+            threadPool->run(threadPool->getNumThreads(),
+                            [this, &parameters, &hessValue](unsigned int thread)
+                            {
+                                calcApproxHessianColumns(thread, parameters, hessValue);
+                            });
+            numGradEvaluations += numParameters;
+        }
+        else
+        {
+            for (Eigen::Index i = 0; i < numParameters; ++i)
+            {
+                hessParameters(i) += epsilon;
+                calcGrad(hessParameters, hessForwardGradient);
+                hessValue.col(i) = (hessForwardGradient - hessGradient) / epsilon;
+                hessParameters(i) = parameters(i);
+            }
+        }
+
+        // The columns are approximated independently, hence the matrix is symmetrized.
+        for (Eigen::Index j = 0; j < numParameters; ++j)
+        {
+            for (Eigen::Index i = j + 1; i < numParameters; ++i)
+            {
+                hessValue(i, j) = hessValue(j, i) = 0.5 * (hessValue(i, j) + hessValue(j, i));
+            }
+        }
+
+        return;
+    }
+
+    if (hasBatch())
+    {
+        calcApproxHessianBatches(parameters, hessValue);
+
+        return;
+    }
+
+    // Balances the truncation error against the cancellation of the second difference.
+    const double epsilon = std::cbrt(DBL_EPSILON);
+    const double invEpsilonSquared = 1.0 / (epsilon * epsilon);
+
+    double funcValue;
+    calcObjFuncValue(parameters, funcValue);
+
+    hessFuncValues.resize(numParameters);
+
+    if (hasParallelHessian())
+    {
+        // The mixed differences need all function values along the coordinates, hence the
+        // threads are run twice.
+        threadPool->run(threadPool->getNumThreads(),
+                        [this, &parameters](unsigned int thread)
+                        {
+                            calcApproxHessianFuncValues(thread, parameters);
+                        });
+        threadPool->run(threadPool->getNumThreads(),
+                        [this, &parameters, funcValue, &hessValue](unsigned int thread)
+                        {
+                            calcApproxHessianRows(thread, parameters, funcValue, hessValue);
+                        });
+        numFuncEvaluations += numParameters * (numParameters + 3) / 2;
+
+        return;
+    }
+
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        hessParameters(i) += epsilon;
+        calcObjFuncValue(hessParameters, hessFuncValues(i));
+        hessParameters(i) = parameters(i);
+    }
+
+    double forwardFuncValue;
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        hessParameters(i) = parameters(i) + 2 * epsilon;
+        calcObjFuncValue(hessParameters, forwardFuncValue);
+        hessValue(i, i) = (forwardFuncValue - 2 * hessFuncValues(i) + funcValue) * invEpsilonSquared;
+
+        hessParameters(i) = parameters(i) + epsilon;
+        for (Eigen::Index j = i + 1; j < numParameters; ++j)
+        {
+            hessParameters(j) += epsilon;
+            calcObjFuncValue(hessParameters, forwardFuncValue);
+            hessValue(i, j) = hessValue(j, i) = (forwardFuncValue - hessFuncValues(i) - hessFuncValues(j) + funcValue) * invEpsilonSquared;
+            hessParameters(j) = parameters(j);
+        }
+        hessParameters(i) = parameters(i);
+    }
+}
+
+/*
+ *  Approximates the columns thread, thread + numThreads, ... of the Hessian with forward
+ *  differences of the gradient, given the gradient at parameters in hessGradient.
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxHessianColumns(unsigned int   thread,
+                                                                                                   const Vector & parameters,
+                                                                                                   Matrix &       hessValue)
+{
+    if constexpr (!std::is_same<Gradient, NoGradient>::value)
+    {
+        const Eigen::Index numParameters = parameters.size();
+        const Eigen::Index numThreads = threadPool->getNumThreads();
+        const double epsilon = std::sqrt(DBL_EPSILON);
+
+        Gradient threadGradFunc = gradFunc;
+        Vector & threadParameters = hessThreadParameters[thread];
+        Vector & threadGradient = hessThreadGradients[thread];
+
+        for (Eigen::Index i = thread; i < numParameters; i += numThreads)
+        {
+            threadParameters(i) += epsilon;
+            threadGradFunc(threadParameters, threadGradient);
+            hessValue.col(i) = (threadGradient - hessGradient) / epsilon;
+            threadParameters(i) = parameters(i);
+        }
+    }
+}
+
+/*
+ *  Evaluates the objective function along the coordinates thread, thread + numThreads, ...
+ *  into hessFuncValues.
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxHessianFuncValues(unsigned int   thread,
+                                                                                                      const Vector & parameters)
+{
+    const Eigen::Index numParameters = parameters.size();
+    const Eigen::Index numThreads = threadPool->getNumThreads();
+    const double epsilon = std::cbrt(DBL_EPSILON);
+
+    Value threadObjFunc = objFunc;
+    Vector & threadParameters = hessThreadParameters[thread];
+
+    for (Eigen::Index i = thread; i < numParameters; i += numThreads)
+    {
+        threadParameters(i) += epsilon;
+        threadObjFunc(threadParameters, hessFuncValues(i));
+        threadParameters(i) = parameters(i);
+    }
+}
+
+/*
+ *  Approximates the rows thread, thread + numThreads, ... of the upper triangle of the
+ *  Hessian with second differences of the function values. Interleaving the rows balances
+ *  their decreasing lengths across the threads.
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxHessianRows(unsigned int   thread,
+                                                                                                const Vector & parameters,
+                                                                                                double         funcValue,
+                                                                                                Matrix &       hessValue)
+{
+    const Eigen::Index numParameters = parameters.size();
+    const Eigen::Index numThreads = threadPool->getNumThreads();
+    const double epsilon = std::cbrt(DBL_EPSILON);
+    const double invEpsilonSquared = 1.0 / (epsilon * epsilon);
+
+    Value threadObjFunc = objFunc;
+    Vector & threadParameters = hessThreadParameters[thread];
+
+    double forwardFuncValue;
+    for (Eigen::Index i = thread; i < numParameters; i += numThreads)
+    {
+        threadParameters(i) = parameters(i) + 2 * epsilon;
+        threadObjFunc(threadParameters, forwardFuncValue);
+        hessValue(i, i) = (forwardFuncValue - 2 * hessFuncValues(i) + funcValue) * invEpsilonSquared;
+
+        threadParameters(i) = parameters(i) + epsilon;
+        for (Eigen::Index j = i + 1; j < numParameters; ++j)
+        {
+            threadParameters(j) += epsilon;
+            threadObjFunc(threadParameters, forwardFuncValue);
+            hessValue(i, j) = hessValue(j, i) = (forwardFuncValue - hessFuncValues(i) - hessFuncValues(j) + funcValue) * invEpsilonSquared;
+            threadParameters(j) = parameters(j);
+        }
+        threadParameters(i) = parameters(i);
+    }
+}
+
+/*
+ *  Approximates the Hessian with second differences of function values evaluated by the
+ *  batch callable. The (n + 1) (n + 2) / 2 points are the unperturbed one, the ones perturbed
+ *  along a single coordinate and the ones perturbed along a pair of coordinates, including
+ *  the pairs of equal coordinates. Their number is a multiple of n + 1 for even n and of
+ *  n + 2 for odd n, hence they are passed in equally sized batches, whose memory is bounded
+ *  like the one of the approximate gradient.
+ */
+
+template <int Dim, class ValueFunc, class GradientFunc, class BatchFunc, class HessianFunc>
+void BasicFunction<Dim, ValueFunc, GradientFunc, BatchFunc, HessianFunc>::calcApproxHessianBatches(const Vector & parameters,
+                                                                                                   Matrix &       hessValue)
+{
+    const Eigen::Index numParameters = parameters.size();
+    const Eigen::Index numPoints = (numParameters + 1) * (numParameters + 2) / 2;
+    const Eigen::Index batchSize = (numParameters % 2 == 0) ? numParameters + 1 : numParameters + 2;
+    const double epsilon = std::cbrt(DBL_EPSILON);
+    const double invEpsilonSquared = 1.0 / (epsilon * epsilon);
+
+    hessFuncValues.resize(numPoints);
+    gradPoints.resize(numParameters, batchSize);
+
+    // The point perturbed along the coordinates i and j, where a negative coordinate is not
+    // perturbed. The points run through the rows i = -1, 0, ..., n - 1 of the pairs with j >= i.
+    Eigen::Index i = -1;
+    Eigen::Index j = -1;
+    for (Eigen::Index first = 0; first < numPoints; first += batchSize)
+    {
+        for (Eigen::Index k = 0; k < batchSize; ++k)
+        {
+            gradPoints.col(k) = parameters;
+            if (i >= 0)
+            {
+                gradPoints(i, k) = parameters(i) + epsilon;
+            }
+            if (j >= 0)
+            {
+                gradPoints(j, k) = parameters(j) + ((i == j) ? 2 * epsilon : epsilon);
+            }
+
+            if (++j == numParameters)
+            {
+                ++i;
+                j = i;
+            }
+        }
+
+        calcObjFuncValues(gradPoints, gradFuncValues);
+        hessFuncValues.segment(first, batchSize) = gradFuncValues;
+    }
+
+    // The values along a single coordinate follow the unperturbed one, the ones of the
+    // row i start at rowStart.
+    const double funcValue = hessFuncValues(0);
+    Eigen::Index rowStart = numParameters + 1;
+    for (i = 0; i < numParameters; ++i)
+    {
+        hessValue(i, i) = (hessFuncValues(rowStart) - 2 * hessFuncValues(1 + i) + funcValue) * invEpsilonSquared;
+        for (j = i + 1; j < numParameters; ++j)
+        {
+            hessValue(i, j) = hessValue(j, i) = (hessFuncValues(rowStart + j - i) - hessFuncValues(1 + i) - hessFuncValues(1 + j) + funcValue) * invEpsilonSquared;
+        }
+        rowStart += numParameters - i;
+    }
+}
+
+extern template class BasicFunction<Eigen::Dynamic,
+                                    Function<Eigen::Dynamic>::Value,
+                                    Function<Eigen::Dynamic>::Gradient,
+                                    Function<Eigen::Dynamic>::Batch,
+                                    Function<Eigen::Dynamic>::Hessian>;
+
 }
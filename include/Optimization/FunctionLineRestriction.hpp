@@ -0,0 +1,172 @@
+#pragma once
+
+#include <type_traits>
+
+#include <Eigen/Dense>
+
+
+namespace Optimization
+{
+
+/*
+ *  Restriction of the objective function to the line through initParameters along direction,
+ *  i.e. phi(stepLength) = f(initParameters + stepLength * direction). The line searches only
+ *  evaluate the objective function through this class.
+ *
+ *  This generic restriction evaluates the objective function at the point on the line. An
+ *  objective function with more structure, e.g. a quadratic one, may evaluate phi and its
+ *  derivative in O(1) after a precomputation in setLine. It supplies such a restriction by
+ *  declaring the nested type LineRestriction with the interface of this class, see
+ *  LineRestrictionOf.
+ */
+
+template <class Objective>
+class FunctionLineRestriction
+{
+    public:
+        typedef typename Objective::Vector Vector;
+
+    public:
+        FunctionLineRestriction(Objective & objFunc);
+
+        /*
+         *  Sets the line together with the function value and the gradient at its origin.
+         *  The vectors must outlive the evaluations on the line.
+         */
+
+        void setLine(const Vector & initParameters,
+                     double         initFuncValue,
+                     const Vector & initGradient,
+                     const Vector & direction);
+
+        double calcValue(double stepLength);
+
+        /*
+         *  Computes the derivative of phi at stepLength, given phi(stepLength) as funcValue.
+         *  If approximate is true and no exact gradient is available, the derivative is
+         *  approximated with a single function evaluation, otherwise the full gradient is
+         *  computed and kept for calcGrad.
+         */
+
+        double calcDerivative(double stepLength,
+                              double funcValue,
+                              bool   approximate = false);
+
+        /*
+         *  Computes the point and the gradient at stepLength. The gradient of the last call of
+         *  calcDerivative at the same step length is reused.
+         */
+
+        void calcGrad(double   stepLength,
+                      Vector & parameters,
+                      Vector & gradient);
+
+    private:
+        Objective *    objFunc;
+
+        const Vector * initParameters;
+        const Vector * direction;
+
+        Vector         parameters;
+        Vector         gradient;
+        double         gradStepLength;
+        bool           gradValid;
+};
+
+/*
+ *  Selects the line restriction used by the line searches for an objective function type:
+ *  Objective::LineRestriction when it is declared, otherwise FunctionLineRestriction.
+ */
+
+template <class Objective, class = void>
+struct LineRestrictionOf
+{
+    typedef FunctionLineRestriction<Objective> Type;
+};
+
+template <class Objective>
+struct LineRestrictionOf<Objective, std::void_t<typename Objective::LineRestriction>>
+{
+    typedef typename Objective::LineRestriction Type;
+};
+
+template <class Objective>
+FunctionLineRestriction<Objective>::FunctionLineRestriction(Objective & objFunc)
+:
+objFunc(&objFunc),
+initParameters(nullptr),
+direction(nullptr),
+gradStepLength(0.0),
+gradValid(false)
+{
+    // Fixed-size vectors are not initialized by Eigen, dynamic ones are empty.
+    parameters.setZero();
+    gradient.setZero();
+}
+
+template <class Objective>
+void FunctionLineRestriction<Objective>::setLine(const Vector & initParameters,
+                                                 double         initFuncValue,
+                                                 const Vector & initGradient,
+                                                 const Vector & direction)
+{
+    this->initParameters = &initParameters;
+    this->direction      = &direction;
+    this->gradValid      = false;
+
+    // The callables expect a sized gradient. Resizing to the current size is a no-op.
+    gradient.resize(initParameters.size());
+}
+
+template <class Objective>
+double FunctionLineRestriction<Objective>::calcValue(double stepLength)
+{
+    double funcValue;
+    parameters = (*initParameters) + stepLength * (*direction);
+    objFunc->calcObjFuncValue(parameters, funcValue);
+
+    return funcValue;
+}
+
+template <class Objective>
+double FunctionLineRestriction<Objective>::calcDerivative(double stepLength,
+                                                          double funcValue,
+                                                          bool   approximate)
+{
+    if (gradValid && gradStepLength == stepLength)
+    {
+        return gradient.dot(*direction);
+    }
+
+    parameters = (*initParameters) + stepLength * (*direction);
+
+    if (approximate && !objFunc->hasGradient())
+    {
+        return objFunc->calcDirectionalDerivative(parameters, funcValue, *direction);
+    }
+
+    objFunc->calcGrad(parameters, gradient);
+    gradStepLength = stepLength;
+    gradValid      = true;
+
+    return gradient.dot(*direction);
+}
+
+template <class Objective>
+void FunctionLineRestriction<Objective>::calcGrad(double   stepLength,
+                                                  Vector & parameters,
+                                                  Vector & gradient)
+{
+    parameters = (*initParameters) + stepLength * (*direction);
+
+    if (gradValid && gradStepLength == stepLength)
+    {
+        gradient = this->gradient;
+    }
+    else
+    {
+        objFunc->calcGrad(parameters, gradient);
+    }
+}
+
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include <Eigen/Dense>
+
+
+namespace Optimization
+{
+
+/*
+ *  Strategy predicting the trial step length the line search starts from. A good prediction
+ *  is accepted by the line search right away, hence the number of line search iterations
+ *  mostly depends on it. The fraction of accepted predictions is reported by the Result.
+ *
+ *  The strategies below are final, hence StaticSolver calls them without virtual dispatch
+ *  when it is given one of them as its Step policy. A strategy whose prediction is not a
+ *  finite positive number, e.g. after a vanishing directional derivative, falls back to its
+ *  step length of the first iteration.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStep
+{
+    public:
+        typedef std::shared_ptr<InitialStep>  Ptr;
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        virtual ~InitialStep() { }
+
+        /*
+         *  Trial step length of the first iteration, which has no history.
+         */
+
+        virtual double initialStepLength(const Vector & gradient,
+                                         const Vector & direction) = 0;
+
+        /*
+         *  Trial step length of the following iterations. The arguments describe the last
+         *  accepted step, where lastGradDotDir is the directional derivative of the objective
+         *  function along the last direction at lastParameters, and the new direction.
+         */
+
+        virtual double nextStepLength(const Vector & parameters,
+                                      const Vector & gradient,
+                                      double         funcValue,
+                                      const Vector & lastParameters,
+                                      const Vector & lastGradient,
+                                      double         lastFuncValue,
+                                      double         lastGradDotDir,
+                                      double         lastStepLength,
+                                      const Vector & direction) = 0;
+};
+
+/*
+ *  Always tries the unit step length, which is the natural one of Newton and quasi-Newton
+ *  directions.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStepUnit final : public InitialStep<Dim>
+{
+    public:
+        typedef typename InitialStep<Dim>::Vector Vector;
+
+    public:
+        inline double initialStepLength(const Vector & gradient,
+                                        const Vector & direction) override
+        {
+            return 1.0;
+        }
+
+        inline double nextStepLength(const Vector & parameters,
+                                     const Vector & gradient,
+                                     double         funcValue,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     double         lastFuncValue,
+                                     double         lastGradDotDir,
+                                     double         lastStepLength,
+                                     const Vector & direction) override
+        {
+            return 1.0;
+        }
+};
+
+/*
+ *  Scales the first step to unit length and keeps the length of the last accepted step
+ *  afterwards, i.e. tries lastStepLength * |lastDirection| / |direction|, as suggested by
+ *  David F. Shanno and Kang-Hoh Phua, Remark on Algorithm 500: Minimization of Unconstrained
+ *  Multivariate Functions, ACM Transactions on Mathematical Software, 6(4), 1980, 618-622
+ *  It suits directions whose length says little about the step, e.g. the conjugate gradient
+ *  and steepest descent ones.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStepShannoPhua final : public InitialStep<Dim>
+{
+    public:
+        typedef typename InitialStep<Dim>::Vector Vector;
+
+    public:
+        inline double initialStepLength(const Vector & gradient,
+                                        const Vector & direction) override
+        {
+            return 1.0 / direction.norm();
+        }
+
+        inline double nextStepLength(const Vector & parameters,
+                                     const Vector & gradient,
+                                     double         funcValue,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     double         lastFuncValue,
+                                     double         lastGradDotDir,
+                                     double         lastStepLength,
+                                     const Vector & direction) override
+        {
+            const double stepLength = (parameters - lastParameters).norm() / direction.norm();
+
+            if (!std::isfinite(stepLength) || stepLength <= 0.0)
+            {
+                return initialStepLength(gradient, direction);
+            }
+
+            return stepLength;
+        }
+};
+
+/*
+ *  Interpolates a quadratic to the last two function values and the last directional
+ *  derivative and takes its minimizer, at most the unit step length, see (3.60) from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 59
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStepQuadratic final : public InitialStep<Dim>
+{
+    public:
+        typedef typename InitialStep<Dim>::Vector Vector;
+
+    public:
+        inline double initialStepLength(const Vector & gradient,
+                                        const Vector & direction) override
+        {
+            return 1.0;
+        }
+
+        inline double nextStepLength(const Vector & parameters,
+                                     const Vector & gradient,
+                                     double         funcValue,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     double         lastFuncValue,
+                                     double         lastGradDotDir,
+                                     double         lastStepLength,
+                                     const Vector & direction) override
+        {
+            const double stepLength = 1.01 * 2 * (funcValue - lastFuncValue) / lastGradDotDir;
+
+            if (!std::isfinite(stepLength) || stepLength <= 0.0)
+            {
+                return initialStepLength(gradient, direction);
+            }
+
+            return std::min(1.0, stepLength);
+        }
+};
+
+/*
+ *  Assumes that the first-order change of the objective function is the same as in the last
+ *  iteration, see Page 59 of Nocedal and Wright. It suits directions that are not scaled,
+ *  e.g. the steepest descent and conjugate gradient ones.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStepRatio final : public InitialStep<Dim>
+{
+    public:
+        typedef typename InitialStep<Dim>::Vector Vector;
+
+    public:
+        inline double initialStepLength(const Vector & gradient,
+                                        const Vector & direction) override
+        {
+            return 1.0;
+        }
+
+        inline double nextStepLength(const Vector & parameters,
+                                     const Vector & gradient,
+                                     double         funcValue,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     double         lastFuncValue,
+                                     double         lastGradDotDir,
+                                     double         lastStepLength,
+                                     const Vector & direction) override
+        {
+            const double stepLength = lastStepLength * lastGradDotDir / gradient.dot(direction);
+
+            if (!std::isfinite(stepLength) || stepLength <= 0.0)
+            {
+                return initialStepLength(gradient, direction);
+            }
+
+            return stepLength;
+        }
+};
+
+/*
+ *  Barzilai-Borwein step length s^T s / s^T y of the last step s and gradient change y, which
+ *  estimates the inverse of the curvature. For directions other than the steepest descent one
+ *  it is taken along the projection of the steepest descent step onto the direction. Without
+ *  positive curvature, and in the first iteration, the step has unit length.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class InitialStepBarzilaiBorwein final : public InitialStep<Dim>
+{
+    public:
+        typedef typename InitialStep<Dim>::Vector Vector;
+
+    public:
+        inline double initialStepLength(const Vector & gradient,
+                                        const Vector & direction) override
+        {
+            return 1.0 / direction.norm();
+        }
+
+        inline double nextStepLength(const Vector & parameters,
+                                     const Vector & gradient,
+                                     double         funcValue,
+                                     const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     double         lastFuncValue,
+                                     double         lastGradDotDir,
+                                     double         lastStepLength,
+                                     const Vector & direction) override
+        {
+            const double sy = (parameters - lastParameters).dot(gradient - lastGradient);
+
+            if (sy <= 0.0)
+            {
+                return 1.0 / direction.norm();
+            }
+
+            const double stepLength = -(parameters - lastParameters).squaredNorm() / sy *
+                                      gradient.dot(direction) / direction.squaredNorm();
+
+            if (!std::isfinite(stepLength) || stepLength <= 0.0)
+            {
+                return initialStepLength(gradient, direction);
+            }
+
+            return stepLength;
+        }
+};
+
+extern template class InitialStep<Eigen::Dynamic>;
+extern template class InitialStepUnit<Eigen::Dynamic>;
+extern template class InitialStepShannoPhua<Eigen::Dynamic>;
+extern template class InitialStepQuadratic<Eigen::Dynamic>;
+extern template class InitialStepRatio<Eigen::Dynamic>;
+extern template class InitialStepBarzilaiBorwein<Eigen::Dynamic>;
+
+}
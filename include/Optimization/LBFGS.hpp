@@ -0,0 +1,177 @@
+#pragma once
+
+#include <Optimization/BaseAlgorithm.hpp>
+#include <Optimization/CompactLBFGS.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Direction policy for StaticSolver. The inverse Hessian is the limited-memory approximation
+ *  of CompactLBFGS, so a direction costs O(mn) time and the solve O(mn) memory.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LBFGSPolicy
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        LBFGSPolicy(unsigned int memory = 5);
+
+        void initialDirection(const Vector & parameters,
+                              const Vector & gradient,
+                              Vector &       direction);
+
+        void updateDirection(const Vector & parameters,
+                             const Vector & gradient,
+                             const Vector & lastParameters,
+                             const Vector & lastGradient,
+                             Vector &       direction);
+
+        inline CompactLBFGS<Dim> & getMatrix()
+        {
+            return matrix;
+        }
+
+        inline const CompactLBFGS<Dim> & getMatrix() const
+        {
+            return matrix;
+        }
+
+    private:
+        CompactLBFGS<Dim> matrix;
+
+        Vector            s;
+        Vector            y;
+};
+
+template <int Dim = Eigen::Dynamic>
+class LBFGS : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector Vector;
+
+    public:
+        LBFGS(Function<Dim> &               objFuncInfo,
+              const Vector &                initialParameters,
+              double                        gradTol = 1e-9,
+              double                        relTol = 1e-9,
+              unsigned int                  maxNumIterations = 100000,
+              typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        ~LBFGS();
+
+        /*
+         *  The number of stored secant pairs. The default value is 5.
+         */
+
+        inline void setMemory(unsigned int memory)
+        {
+            policy.getMatrix().setMemory(memory);
+        }
+
+        inline unsigned int getMemory() const
+        {
+            return policy.getMatrix().getMemory();
+        }
+
+    private:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
+    private:
+        LBFGSPolicy<Dim> policy;
+};
+
+template <int Dim>
+LBFGSPolicy<Dim>::LBFGSPolicy(unsigned int memory)
+                              :
+                              matrix(memory)
+{
+
+}
+
+template <int Dim>
+void LBFGSPolicy<Dim>::initialDirection(const Vector & parameters,
+                                        const Vector & gradient,
+                                        Vector &       direction)
+{
+    matrix.reset(parameters.size());
+
+    // Same first step as BFGS
+    direction = -gradient / gradient.norm();
+}
+
+/*
+ *  Implements the L-BFGS Algorithm 7.5 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 179
+ *  with the compact representation instead of the two-loop recursion. A pair without
+ *  sufficient curvature is skipped, keeping the older ones.
+ */
+
+template <int Dim>
+void LBFGSPolicy<Dim>::updateDirection(const Vector & parameters,
+                                       const Vector & gradient,
+                                       const Vector & lastParameters,
+                                       const Vector & lastGradient,
+                                       Vector &       direction)
+{
+    s = parameters - lastParameters;
+    y = gradient - lastGradient;
+
+    if (!matrix.update(s, y) && matrix.getNumPairs() == 0)
+    {
+        // Without curvature information fall back to steepest descent.
+        direction = -gradient / gradient.norm();
+        return;
+    }
+
+    matrix.applyInverseHessian(gradient, direction);
+    direction = -direction;
+}
+
+template <int Dim>
+LBFGS<Dim>::LBFGS(Function<Dim> &               objFuncInfo,
+                  const Vector &                initialParameters,
+                  double                        gradTol,
+                  double                        relTol,
+                  unsigned int                  maxNumIterations,
+                  typename LineSearch<Dim>::Ptr lineSearch)
+                  :
+                  BaseAlgorithm<Dim>(objFuncInfo,
+                                     initialParameters,
+                                     gradTol,
+                                     relTol,
+                                     maxNumIterations,
+                                     lineSearch)
+{
+    this->setInitialStep(std::make_shared<InitialStepUnit<Dim>>());
+}
+
+template <int Dim>
+LBFGS<Dim>::~LBFGS()
+{
+
+}
+
+extern template class LBFGSPolicy<Eigen::Dynamic>;
+extern template class LBFGS<Eigen::Dynamic>;
+
+}
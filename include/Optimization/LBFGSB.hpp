@@ -0,0 +1,642 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Optimization/CompactLBFGS.hpp>
+#include <Optimization/Function.hpp>
+#include <Optimization/LineSearchNocedal.hpp>
+#include <Optimization/Result.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Limited-memory BFGS method for bound constraints lower <= x <= upper. Unbounded parameters
+ *  get infinite bounds. Every iteration
+ *
+ *      1. finds the generalized Cauchy point, the first local minimizer of the quadratic model
+ *         along the projected steepest descent path, which fixes the active set,
+ *      2. minimizes the model over the parameters which are free at the Cauchy point,
+ *      3. searches along the line to the resulting point with LineSearchNocedalPolicy, whose
+ *         step length is limited to the part of the line inside of the bounds.
+ *
+ *  The quadratic model is the one of CompactLBFGS, hence time and memory per iteration are
+ *  O(mn). If the search direction is not a descent direction or the line search fails, the
+ *  limited-memory matrix is discarded and the iteration is repeated once.
+ *
+ *  The gradient tolerance applies to the infinity norm of the projected gradient
+ *  P(x - g) - x, which is also reported as the gradient norm of the result.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LBFGSB
+{
+    public:
+        typedef typename Function<Dim>::Vector Vector;
+
+    public:
+        LBFGSB(Function<Dim> & objFunc,
+               const Vector &  lowerBounds,
+               const Vector &  upperBounds,
+               const Vector &  initialParameters,
+               double          gradTol = 1e-9,
+               double          relTol = 1e-9,
+               unsigned int    maxNumIterations = 100000);
+
+        ~LBFGSB();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        /*
+         *  Every lower bound must be less than or equal to the upper bound.
+         */
+
+        void setBounds(const Vector & lowerBounds,
+                       const Vector & upperBounds);
+        const Vector & getLowerBounds() const;
+        const Vector & getUpperBounds() const;
+
+        unsigned int getNumIterations() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  The number of stored secant pairs. The default value is 5.
+         */
+
+        inline void setMemory(unsigned int memory)
+        {
+            matrix.setMemory(memory);
+        }
+
+        inline unsigned int getMemory() const
+        {
+            return matrix.getMemory();
+        }
+
+        inline LineSearchNocedalPolicy<Function<Dim>> & getLineSearch()
+        {
+            return lineSearch;
+        }
+
+    private:
+        double computeProjGradNorm() const;
+
+        void computeCauchyPoint();
+
+        void minimizeSubspace();
+
+        bool computeDirection();
+
+        bool searchLine(double & funcValue);
+
+    private:
+        Vector                                          initialParameters;
+        Vector                                          lowerBounds;
+        Vector                                          upperBounds;
+
+        double                                          gradTol;
+        double                                          relTol;
+        unsigned int                                    numIterations;
+        unsigned int                                    maxNumIterations;
+
+        CompactLBFGS<Dim>                               matrix;
+        LineSearchNocedalPolicy<Function<Dim>>          lineSearch;
+
+        Vector                                          parameters;
+        Vector                                          gradient;
+        Vector                                          lastParameters;
+        Vector                                          lastGradient;
+        Vector                                          cauchyPoint;
+        Vector                                          direction;
+        Vector                                          step;
+        Vector                                          s;
+        Vector                                          y;
+
+        // Breakpoints of the projected steepest descent path, kept as a heap.
+        std::vector<std::pair<double, Eigen::Index>>    breakpoints;
+        std::vector<Eigen::Index>                       freeIndices;
+
+        Eigen::VectorXd                                 p;
+        Eigen::VectorXd                                 c;
+        Eigen::VectorXd                                 wRow;
+        Eigen::VectorXd                                 middleProduct;
+        Eigen::VectorXd                                 reducedGradient;
+        Eigen::VectorXd                                 reducedStep;
+
+        Function<Dim> *                                 objFunc;
+};
+
+template <int Dim>
+LBFGSB<Dim>::LBFGSB(Function<Dim> & objFunc,
+                    const Vector &  lowerBounds,
+                    const Vector &  upperBounds,
+                    const Vector &  initialParameters,
+                    double          gradTol,
+                    double          relTol,
+                    unsigned int    maxNumIterations)
+                    :
+                    lineSearch(objFunc)
+{
+    setInitialParameters(initialParameters);
+    setBounds(lowerBounds, upperBounds);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    setMaxNumIterations(maxNumIterations);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+LBFGSB<Dim>::~LBFGSB()
+{
+
+}
+
+template <int Dim>
+double LBFGSB<Dim>::computeProjGradNorm() const
+{
+    double norm = 0.0;
+
+    for (Eigen::Index i = 0; i < parameters.size(); ++i)
+    {
+        const double projected = std::min(std::max(parameters(i) - gradient(i), lowerBounds(i)), upperBounds(i));
+        norm = std::max(norm, std::fabs(projected - parameters(i)));
+    }
+
+    return norm;
+}
+
+/*
+ *  Implements the generalized Cauchy point Algorithm CP from
+ *  Richard H. Byrd, Peihuang Lu, Jorge Nocedal and Ciyou Zhu, A Limited Memory Algorithm for
+ *  Bound Constrained Optimization, SIAM Journal on Scientific Computing, 16(5), 1995
+ *  The breakpoints are taken from a heap, so only the segments up to the Cauchy point are
+ *  sorted, and every segment costs O(m^2).
+ */
+
+template <int Dim>
+void LBFGSB<Dim>::computeCauchyPoint()
+{
+    const Eigen::Index numParameters = parameters.size();
+    const double theta = matrix.getTheta();
+
+    cauchyPoint = parameters;
+    direction.setZero(numParameters);
+    breakpoints.clear();
+
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        double breakpoint = std::numeric_limits<double>::infinity();
+
+        if (gradient(i) < 0.0)
+        {
+            breakpoint = (parameters(i) - upperBounds(i)) / gradient(i);
+        }
+        else if (gradient(i) > 0.0)
+        {
+            breakpoint = (parameters(i) - lowerBounds(i)) / gradient(i);
+        }
+
+        // The parameter is at a bound which the path leaves immediately.
+        if (breakpoint <= 0.0 || gradient(i) == 0.0)
+        {
+            continue;
+        }
+
+        direction(i) = -gradient(i);
+
+        if (breakpoint < std::numeric_limits<double>::infinity())
+        {
+            breakpoints.emplace_back(breakpoint, i);
+        }
+    }
+
+    std::greater<std::pair<double, Eigen::Index>> later;
+    std::make_heap(breakpoints.begin(), breakpoints.end(), later);
+
+    // Derivatives of the model along the path, with p = W^T d and c = W^T (x^cp - x).
+    matrix.applyWTranspose(direction, p);
+    c.setZero(p.size());
+
+    matrix.applyMiddle(p, middleProduct);
+
+    double derivative = -direction.squaredNorm();
+    double curvature = -theta * derivative - p.dot(middleProduct);
+    const double minCurvature = DBL_EPSILON * curvature;
+
+    double minStep = -derivative / curvature;
+    double lastBreakpoint = 0.0;
+
+    while (!breakpoints.empty())
+    {
+        std::pop_heap(breakpoints.begin(), breakpoints.end(), later);
+        const double breakpoint = breakpoints.back().first;
+        const Eigen::Index b = breakpoints.back().second;
+        breakpoints.pop_back();
+
+        const double segment = breakpoint - lastBreakpoint;
+
+        // The minimizer lies on the current segment.
+        if (minStep < segment)
+        {
+            break;
+        }
+
+        // Fix the parameter at the bound it reaches.
+        cauchyPoint(b) = (direction(b) > 0.0) ? upperBounds(b) : lowerBounds(b);
+
+        const double z = cauchyPoint(b) - parameters(b);
+        const double g = gradient(b);
+
+        c += segment * p;
+
+        matrix.getWRow(b, wRow);
+        matrix.applyMiddle(wRow, middleProduct);
+
+        derivative += segment * curvature + g * g + theta * g * z - g * middleProduct.dot(c);
+        curvature  -= theta * g * g + 2.0 * g * middleProduct.dot(p) + g * g * wRow.dot(middleProduct);
+        curvature   = std::max(curvature, minCurvature);
+
+        p += g * wRow;
+        direction(b) = 0.0;
+
+        minStep = -derivative / curvature;
+        lastBreakpoint = breakpoint;
+    }
+
+    minStep = std::max(minStep, 0.0);
+    lastBreakpoint += minStep;
+
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        if (direction(i) != 0.0)
+        {
+            cauchyPoint(i) = std::min(std::max(parameters(i) + lastBreakpoint * direction(i), lowerBounds(i)), upperBounds(i));
+        }
+    }
+
+    c += minStep * p;
+}
+
+/*
+ *  Implements the direct primal method of Section 5.1 from
+ *  Richard H. Byrd, Peihuang Lu, Jorge Nocedal and Ciyou Zhu, A Limited Memory Algorithm for
+ *  Bound Constrained Optimization, SIAM Journal on Scientific Computing, 16(5), 1995
+ *  The unconstrained minimizer over the free parameters is projected onto the bounds, as
+ *  proposed by Morales and Nocedal, and truncated to the bounds instead if the projection
+ *  does not give a descent direction.
+ */
+
+template <int Dim>
+void LBFGSB<Dim>::minimizeSubspace()
+{
+    const Eigen::Index numParameters = parameters.size();
+    const double theta = matrix.getTheta();
+
+    freeIndices.clear();
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        if (lowerBounds(i) < cauchyPoint(i) && cauchyPoint(i) < upperBounds(i))
+        {
+            freeIndices.push_back(i);
+        }
+    }
+
+    direction = cauchyPoint - parameters;
+
+    const Eigen::Index numFree = static_cast<Eigen::Index>(freeIndices.size());
+    if (numFree == 0)
+    {
+        return;
+    }
+
+    // Reduced gradient of the model at the Cauchy point, Z^T (g + theta (x^cp - x) - W M c).
+    matrix.applyMiddle(c, middleProduct);
+    matrix.applyW(middleProduct, step);
+
+    reducedGradient.resize(numFree);
+    for (Eigen::Index j = 0; j < numFree; ++j)
+    {
+        const Eigen::Index i = freeIndices[j];
+
+        reducedGradient(j) = gradient(i) + theta * direction(i) - step(i);
+    }
+
+    matrix.solveReduced(freeIndices, reducedGradient, reducedStep);
+
+    // Projection of x^cp - reducedStep onto the bounds.
+    double gradDotDir = gradient.dot(direction);
+    for (Eigen::Index j = 0; j < numFree; ++j)
+    {
+        const Eigen::Index i = freeIndices[j];
+        const double projected = std::min(std::max(cauchyPoint(i) - reducedStep(j), lowerBounds(i)), upperBounds(i));
+
+        gradDotDir += gradient(i) * (projected - cauchyPoint(i));
+    }
+
+    double stepLength = 1.0;
+    if (gradDotDir >= 0.0)
+    {
+        // Truncation keeps the minimizer of the model on the segment, a descent direction.
+        for (Eigen::Index j = 0; j < numFree; ++j)
+        {
+            const Eigen::Index i = freeIndices[j];
+
+            if (reducedStep(j) < 0.0)
+            {
+                stepLength = std::min(stepLength, (cauchyPoint(i) - upperBounds(i)) / reducedStep(j));
+            }
+            else if (reducedStep(j) > 0.0)
+            {
+                stepLength = std::min(stepLength, (cauchyPoint(i) - lowerBounds(i)) / reducedStep(j));
+            }
+        }
+    }
+
+    for (Eigen::Index j = 0; j < numFree; ++j)
+    {
+        const Eigen::Index i = freeIndices[j];
+        const double minimizer = cauchyPoint(i) - stepLength * reducedStep(j);
+
+        direction(i) = std::min(std::max(minimizer, lowerBounds(i)), upperBounds(i)) - parameters(i);
+    }
+}
+
+/*
+ *  Computes the direction from the parameters to the minimizer of the model. Returns false
+ *  if it is not a descent direction.
+ */
+
+template <int Dim>
+bool LBFGSB<Dim>::computeDirection()
+{
+    computeCauchyPoint();
+    minimizeSubspace();
+
+    return gradient.dot(direction) < 0.0;
+}
+
+/*
+ *  Searches along the direction from lastParameters, with the step length limited to the
+ *  bounds. The first step has unit length without secant pairs and reaches the minimizer of
+ *  the model otherwise.
+ */
+
+template <int Dim>
+bool LBFGSB<Dim>::searchLine(double & funcValue)
+{
+    double maxStepLength = std::numeric_limits<double>::infinity();
+
+    for (Eigen::Index i = 0; i < direction.size(); ++i)
+    {
+        if (direction(i) > 0.0)
+        {
+            maxStepLength = std::min(maxStepLength, (upperBounds(i) - lastParameters(i)) / direction(i));
+        }
+        else if (direction(i) < 0.0)
+        {
+            maxStepLength = std::min(maxStepLength, (lowerBounds(i) - lastParameters(i)) / direction(i));
+        }
+    }
+
+    if (!(maxStepLength > 0.0))
+    {
+        return false;
+    }
+
+    double stepLength = (matrix.getNumPairs() == 0) ? 1.0 / direction.norm() : 1.0;
+
+    lineSearch.setMaxStepLength(maxStepLength);
+    if (!lineSearch.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength))
+    {
+        return false;
+    }
+
+    // Remove the rounding errors of the last step.
+    parameters = parameters.cwiseMax(lowerBounds).cwiseMin(upperBounds);
+
+    return true;
+}
+
+template <int Dim>
+void LBFGSB<Dim>::solve(Result & result)
+{
+    const Eigen::Index numParameters = initialParameters.size();
+
+    if (lowerBounds.size() != numParameters || upperBounds.size() != numParameters)
+    {
+        throw std::invalid_argument("Bounds and initial parameters must have the same size.");
+    }
+
+    double funcValue;
+    double lastFuncValue;
+    double projGradNorm;
+
+    parameters = initialParameters.cwiseMax(lowerBounds).cwiseMin(upperBounds);
+    gradient.resize(numParameters);
+
+    matrix.reset(numParameters);
+    breakpoints.reserve(numParameters);
+    freeIndices.reserve(numParameters);
+
+    numIterations = 0;
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Evaluate the function and its gradient.
+    objFunc->calcObjFuncValue(parameters, funcValue);
+    objFunc->calcGrad(parameters, gradient);
+
+    // Ensure that the initial parameters are not a minimizer.
+    projGradNorm = computeProjGradNorm();
+    if (projGradNorm <= gradTol)
+    {
+        result.set(Gradient, parameters, funcValue, projGradNorm, numIterations,
+                   objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+        return;
+    }
+
+    while (true)
+    {
+        ++numIterations;
+
+        lastParameters = parameters;
+        lastGradient   = gradient;
+        lastFuncValue  = funcValue;
+
+        bool success = computeDirection() && searchLine(funcValue);
+
+        if (!success && matrix.getNumPairs() > 0)
+        {
+            // Retry along the projected steepest descent path.
+            parameters = lastParameters;
+            gradient   = lastGradient;
+            funcValue  = lastFuncValue;
+
+            matrix.reset(numParameters);
+            success = computeDirection() && searchLine(funcValue);
+        }
+
+        if (!success)
+        {
+            parameters = lastParameters;
+            gradient   = lastGradient;
+            result.set(LineSearchFailed, parameters, lastFuncValue, computeProjGradNorm(), numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        s = parameters - lastParameters;
+        y = gradient - lastGradient;
+        matrix.update(s, y);
+
+        // Gradient convergence test.
+        projGradNorm = computeProjGradNorm();
+        if (projGradNorm <= gradTol)
+        {
+            result.set(Gradient, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Relative convergence test.
+        if (std::fabs(funcValue - lastFuncValue) <= relTol * std::fabs(funcValue))
+        {
+            result.set(Relative, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void LBFGSB<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename LBFGSB<Dim>::Vector & LBFGSB<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+void LBFGSB<Dim>::setBounds(const Vector & lowerBounds,
+                            const Vector & upperBounds)
+{
+    if (lowerBounds.size() != upperBounds.size())
+    {
+        throw std::invalid_argument("Lower and upper bounds must have the same size.");
+    }
+
+    if ((lowerBounds.array() > upperBounds.array()).any())
+    {
+        throw std::invalid_argument("Lower bounds must be less than or equal to upper bounds.");
+    }
+
+    this->lowerBounds = lowerBounds;
+    this->upperBounds = upperBounds;
+}
+
+template <int Dim>
+const typename LBFGSB<Dim>::Vector & LBFGSB<Dim>::getLowerBounds() const
+{
+    return lowerBounds;
+}
+
+template <int Dim>
+const typename LBFGSB<Dim>::Vector & LBFGSB<Dim>::getUpperBounds() const
+{
+    return upperBounds;
+}
+
+template <int Dim>
+unsigned int LBFGSB<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+void LBFGSB<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int LBFGSB<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+void LBFGSB<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double LBFGSB<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void LBFGSB<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double LBFGSB<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+extern template class LBFGSB<Eigen::Dynamic>;
+
+}
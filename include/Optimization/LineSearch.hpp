@@ -1,34 +1,59 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 
 #include <Eigen/Dense>
 #include <Optimization/Function.hpp>
+#include <Optimization/FunctionLineRestriction.hpp>
+#include <Optimization/Result.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class LineSearch 
+template <int Dim = Eigen::Dynamic>
+class LineSearch
 {
     public:
         typedef std::shared_ptr<LineSearch> Ptr;
-        
+        typedef typename Function<Dim>::Vector Vector;
+
     public:
-        LineSearch(Function &   objFunc,
-                   unsigned int maxNumIterations);
-        
+        LineSearch(Function<Dim> & objFunc,
+                   unsigned int    maxNumIterations);
+
         virtual ~LineSearch() { }
-        
-        virtual bool search(const Eigen::VectorXd & lastParameters,
-                            const Eigen::VectorXd & lastGradient,
-                            const Eigen::VectorXd & direction,
-                            Eigen::VectorXd &       parameters,
-                            double &                funcValue,
-                            Eigen::VectorXd &       gradient,
-                            double &                stepLength) = 0;
-
-        /* 
+
+        virtual bool search(const Vector & lastParameters,
+                            const Vector & lastGradient,
+                            const Vector & direction,
+                            Vector &       parameters,
+                            double &       funcValue,
+                            Vector &       gradient,
+                            double &       stepLength) = 0;
+
+        /*
+         *  Called by the algorithm before a solve, e.g. to reset statistics gathered over the
+         *  line searches of a solve.
+         */
+
+        virtual void reset() { }
+
+        /*
+         *  Called by the algorithm after a solve, also if the solve throws, e.g. to undo
+         *  changes of the objective function made by reset.
+         */
+
+        virtual void finish() { }
+
+        /*
+         *  Called by the algorithm after a successful solve to add information to its result.
+         */
+
+        virtual void report(Result & result) const { }
+
+        /*
          *  The maximum number of allowed line search iterations.
          *  The default value is 1,000.
          */
@@ -37,8 +62,34 @@ class LineSearch
         unsigned int getMaxNumIterations() const;
 
     protected:
-        Function *   objFunc;
-        unsigned int maxNumIterations;   
+        Function<Dim> * objFunc;
+        unsigned int    maxNumIterations;
 };
 
+template <int Dim>
+LineSearch<Dim>::LineSearch(Function<Dim> & objFunc,
+                            unsigned int    maxNumIterations)
+{
+    this->objFunc = &objFunc;
+    setMaxNumIterations(maxNumIterations);
+}
+
+template <int Dim>
+void LineSearch<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int LineSearch<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+extern template class LineSearch<Eigen::Dynamic>;
+
 }
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchNocedal.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search choosing between LineSearchNocedal and LineSearchBackTrack at runtime. Which of
+ *  them is faster depends on the cost of a gradient relative to a function value, which differs
+ *  greatly between exact and approximate gradients, and on how much progress their steps make.
+ *
+ *  It enables the cost measurement of the objective function for the duration of a solve, see
+ *  BasicFunction::setMeasureCost, and restores the previous setting in finish. It keeps for
+ *  each line search the mean numbers of function and gradient evaluations per search as well
+ *  as the mean progress per search, measured as the relative decrease of the function value.
+ *  The line search with the least expected time per unit of progress is used, and it is only
+ *  replaced if the other one is expected to be faster by more than ten percent.
+ *  Both line searches are tried for numTrialSearches searches at the beginning of a solve and
+ *  the one not in use is tried again at the end of every explorationPeriod searches, so that
+ *  the choice follows changes of the costs. If the line search in use fails, the other one is
+ *  tried in the same iteration. The first choice and every change of it are logged in the
+ *  Result. The expected times use the measured wall times of the callables, hence the
+ *  decisions may differ between runs, unless only function values are evaluated, e.g. with
+ *  an approximate gradient, where they depend on the evaluation counts alone.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchAdaptive : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchAdaptive(Function<Dim> &    objFunc,
+                           const unsigned int numTrialSearches = 5,
+                           const unsigned int explorationPeriod = 100,
+                           const unsigned int maxNumIterations = 1000);
+
+        ~LineSearchAdaptive();
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength) override;
+
+        void reset() override;
+
+        void finish() override;
+
+        void report(Result & result) const override;
+
+        void setExploration(unsigned int numTrialSearches, unsigned int explorationPeriod);
+        unsigned int getNumTrialSearches() const;
+        unsigned int getExplorationPeriod() const;
+
+    private:
+        enum Candidate
+        {
+            Nocedal,
+            BackTrack,
+            NumCandidates
+        };
+
+        struct Statistics
+        {
+            double       numFuncEvaluations;
+            double       numGradEvaluations;
+            double       progress;
+            unsigned int numSamples;
+        };
+
+        unsigned int selectCandidate();
+
+        double calcExpectedTime(unsigned int candidate) const;
+
+        bool searchWith(unsigned int   candidate,
+                        const Vector & lastParameters,
+                        const Vector & lastGradient,
+                        const Vector & direction,
+                        Vector &       parameters,
+                        double &       funcValue,
+                        Vector &       gradient,
+                        double &       stepLength);
+
+    private:
+        typename LineSearch<Dim>::Ptr   candidates[NumCandidates];
+        Statistics                      statistics[NumCandidates];
+
+        unsigned int                    numTrialSearches;
+        unsigned int                    explorationPeriod;
+
+        unsigned int                    numSearches;
+        unsigned int                    chosen;
+
+        std::vector<LineSearchDecision> decisions;
+
+        bool                            measureCost;
+
+        static constexpr double         switchMargin = 1.1;
+};
+
+template <int Dim>
+LineSearchAdaptive<Dim>::LineSearchAdaptive(Function<Dim> &    objFunc,
+                                            const unsigned int numTrialSearches,
+                                            const unsigned int explorationPeriod,
+                                            const unsigned int maxNumIterations)
+                                            :
+                                            LineSearch<Dim>(objFunc,
+                                                            maxNumIterations)
+{
+    candidates[Nocedal]   = std::make_shared<LineSearchNocedal<Dim>>(objFunc);
+    candidates[BackTrack] = std::make_shared<LineSearchBackTrack<Dim>>(objFunc);
+
+    setExploration(numTrialSearches, explorationPeriod);
+
+    for (unsigned int i = 0; i < NumCandidates; ++i)
+    {
+        statistics[i] = {0.0, 0.0, 0.0, 0};
+    }
+
+    numSearches = 0;
+    chosen      = NumCandidates;
+    measureCost = objFunc.getMeasureCost();
+}
+
+template <int Dim>
+LineSearchAdaptive<Dim>::~LineSearchAdaptive()
+{
+
+}
+
+template <int Dim>
+bool LineSearchAdaptive<Dim>::search(const Vector & lastParameters,
+                                     const Vector & lastGradient,
+                                     const Vector & direction,
+                                     Vector &       parameters,
+                                     double &       funcValue,
+                                     Vector &       gradient,
+                                     double &       stepLength)
+{
+    const unsigned int active = selectCandidate();
+
+    ++numSearches;
+
+    // The other line search gets the same input if the active one fails.
+    const double initFuncValue  = funcValue;
+    const double initStepLength = stepLength;
+
+    if (searchWith(active, lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength))
+    {
+        return true;
+    }
+
+    funcValue  = initFuncValue;
+    stepLength = initStepLength;
+
+    return searchWith(1 - active, lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+}
+
+template <int Dim>
+void LineSearchAdaptive<Dim>::reset()
+{
+    for (unsigned int i = 0; i < NumCandidates; ++i)
+    {
+        statistics[i] = {0.0, 0.0, 0.0, 0};
+    }
+
+    numSearches = 0;
+    chosen      = NumCandidates;
+
+    // Keeps the capacity, hence repeated solves do not allocate.
+    decisions.clear();
+
+    // Measure the costs during the solve only, the setting of the user is restored in finish.
+    measureCost = this->objFunc->getMeasureCost();
+    this->objFunc->setMeasureCost(true);
+}
+
+template <int Dim>
+void LineSearchAdaptive<Dim>::report(Result & result) const
+{
+    for (const LineSearchDecision & decision : decisions)
+    {
+        result.addLineSearchDecision(decision);
+    }
+}
+
+template <int Dim>
+void LineSearchAdaptive<Dim>::finish()
+{
+    this->objFunc->setMeasureCost(measureCost);
+}
+
+template <int Dim>
+unsigned int LineSearchAdaptive<Dim>::selectCandidate()
+{
+    // Try both line searches first.
+    if (numSearches < NumCandidates * numTrialSearches)
+    {
+        return numSearches / numTrialSearches;
+    }
+
+    const unsigned int position = (numSearches - NumCandidates * numTrialSearches) % explorationPeriod;
+
+    // Choose the line search to use for the coming period.
+    if (position == 0)
+    {
+        const double nocedalTime   = calcExpectedTime(Nocedal);
+        const double backTrackTime = calcExpectedTime(BackTrack);
+
+        unsigned int best;
+        if (chosen == NumCandidates)
+        {
+            // Ties of the first choice, e.g. if neither line search made progress, go to Nocedal.
+            best = (backTrackTime < nocedalTime) ? BackTrack : Nocedal;
+        }
+        else
+        {
+            // The other line search has to be faster by a margin, so that the choice does not
+            // follow the noise of the measured costs.
+            const double chosenTime = (chosen == Nocedal) ? nocedalTime : backTrackTime;
+            const double otherTime  = (chosen == Nocedal) ? backTrackTime : nocedalTime;
+
+            best = (otherTime * switchMargin < chosenTime) ? 1 - chosen : chosen;
+        }
+
+        if (best != chosen)
+        {
+            chosen = best;
+            decisions.push_back({numSearches + 1,
+                                 chosen == Nocedal ? "Nocedal" : "Backtracking",
+                                 this->objFunc->getFuncEvaluationCost(),
+                                 this->objFunc->getGradEvaluationCost()});
+        }
+    }
+
+    // Try the other line search again at the end of the period.
+    if (position + numTrialSearches >= explorationPeriod)
+    {
+        return 1 - chosen;
+    }
+
+    return chosen;
+}
+
+template <int Dim>
+double LineSearchAdaptive<Dim>::calcExpectedTime(unsigned int candidate) const
+{
+    const Statistics & stats = statistics[candidate];
+
+    if (stats.numSamples == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const double time = stats.numFuncEvaluations * this->objFunc->getFuncEvaluationCost() +
+                        stats.numGradEvaluations * this->objFunc->getGradEvaluationCost();
+
+    return time / stats.progress;
+}
+
+template <int Dim>
+bool LineSearchAdaptive<Dim>::searchWith(unsigned int   candidate,
+                                         const Vector & lastParameters,
+                                         const Vector & lastGradient,
+                                         const Vector & direction,
+                                         Vector &       parameters,
+                                         double &       funcValue,
+                                         Vector &       gradient,
+                                         double &       stepLength)
+{
+    const unsigned int numFuncEvaluations = this->objFunc->getNumFuncEvaluations();
+    const unsigned int numGradEvaluations = this->objFunc->getNumGradEvaluations();
+    const double       lastFuncValue      = funcValue;
+
+    candidates[candidate]->setMaxNumIterations(this->maxNumIterations);
+
+    if (!candidates[candidate]->search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength))
+    {
+        return false;
+    }
+
+    // Relative decrease of the function value, which is positive after every step satisfying
+    // the Armijo condition. Otherwise, the search is not sampled.
+    const double progress = (lastFuncValue - funcValue) / (std::fabs(lastFuncValue) + std::fabs(funcValue));
+    if (!(progress > 0.0))
+    {
+        return true;
+    }
+
+    // Running mean over the first samples, exponential moving average afterwards.
+    Statistics & stats = statistics[candidate];
+    stats.numSamples = std::min(stats.numSamples + 1, 10u);
+
+    const double weight = 1.0 / stats.numSamples;
+    stats.numFuncEvaluations += weight * ((this->objFunc->getNumFuncEvaluations() - numFuncEvaluations) - stats.numFuncEvaluations);
+    stats.numGradEvaluations += weight * ((this->objFunc->getNumGradEvaluations() - numGradEvaluations) - stats.numGradEvaluations);
+    stats.progress           += weight * (progress - stats.progress);
+
+    return true;
+}
+
+template <int Dim>
+void LineSearchAdaptive<Dim>::setExploration(unsigned int numTrialSearches, unsigned int explorationPeriod)
+{
+    if (numTrialSearches < 1)
+    {
+        throw std::invalid_argument("Number of trial searches must be greater than zero.");
+    }
+
+    if (explorationPeriod <= numTrialSearches)
+    {
+        throw std::invalid_argument("Exploration period must be greater than the number of trial searches.");
+    }
+
+    this->numTrialSearches  = numTrialSearches;
+    this->explorationPeriod = explorationPeriod;
+}
+
+template <int Dim>
+unsigned int LineSearchAdaptive<Dim>::getNumTrialSearches() const
+{
+    return numTrialSearches;
+}
+
+template <int Dim>
+unsigned int LineSearchAdaptive<Dim>::getExplorationPeriod() const
+{
+    return explorationPeriod;
+}
+
+extern template class LineSearchAdaptive<Eigen::Dynamic>;
+
+}
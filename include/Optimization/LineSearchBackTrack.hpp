@@ -1,61 +1,267 @@
 #pragma once
 
+#include <stdexcept>
+
 #include <Eigen/Dense>
 #include <Optimization/LineSearch.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class LineSearchBackTrack : public LineSearch 
+/*
+ *  Line search policy for StaticSolver. The objective function type is a template
+ *  parameter, hence its calls are resolved at compile time and may be inlined.
+ */
+
+template <class Objective>
+class LineSearchBackTrackPolicy
 {
     public:
-        LineSearchBackTrack(Function &         objFunc,
-                            const double       armijoCoeff = 1e-4,
-                            const double       contractionCoeff = 0.5,
-                            const unsigned int maxNumIterations = 1000);
-        
-        ~LineSearchBackTrack();
-        
-        bool search(const Eigen::VectorXd & lastParameters,
-                    const Eigen::VectorXd & lastGradient,
-                    const Eigen::VectorXd & direction,
-                    Eigen::VectorXd &       parameters,
-                    double &                funcValue,
-                    Eigen::VectorXd &       gradient,
-                    double &                stepLength) override;
-        
+        typedef typename Objective::Vector                   Vector;
+        typedef typename LineRestrictionOf<Objective>::Type Restriction;
+
+    public:
+        LineSearchBackTrackPolicy(Objective &        objFunc,
+                                  const double       armijoCoeff = 1e-4,
+                                  const double       contractionCoeff = 0.5,
+                                  const unsigned int maxNumIterations = 1000);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
         void setCoefficients(double armijoCoeff, double contractionCoeff);
         double getArmijoCoeff() const;
         double getContractionCoeff() const;
-        
-    private:        
-        inline void evalFunc(double            stepLength,
-                             Eigen::VectorXd & parameters,
-                             double &          funcValue) const 
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+    private:
+        inline void evalFunc(double   stepLength,
+                             double & funcValue)
         {
-            parameters = (*initParameters) + stepLength * (*direction);
-            objFunc->calcObjFuncValue(parameters, funcValue);
+            funcValue = restriction.calcValue(stepLength);
 
             return;
         }
-        
+
         inline bool checkArmijo(double stepLength,
-                                double funcValue) const 
+                                double funcValue) const
         {
             // Check the Armijo os sufficient decrease condition.
             return funcValue <= (armijoLineIntercept + stepLength * armijoLineSlope);
         }
-        
+
+    private:
+        Restriction    restriction;
+        unsigned int   maxNumIterations;
+
+        double         armijoCoeff;
+        double         contractionCoeff;
+
+        double         armijoLineIntercept;
+        double         armijoLineSlope;
+        unsigned int   numIterations;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchBackTrackPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchBackTrack : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchBackTrack(Function<Dim> &    objFunc,
+                            const double       armijoCoeff = 1e-4,
+                            const double       contractionCoeff = 0.5,
+                            const unsigned int maxNumIterations = 1000);
+
+        ~LineSearchBackTrack();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            policy.setMaxNumIterations(this->maxNumIterations);
+
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+        inline void setCoefficients(double armijoCoeff, double contractionCoeff)
+        {
+            policy.setCoefficients(armijoCoeff, contractionCoeff);
+        }
+
+        inline double getArmijoCoeff() const
+        {
+            return policy.getArmijoCoeff();
+        }
+
+        inline double getContractionCoeff() const
+        {
+            return policy.getContractionCoeff();
+        }
+
     private:
-        double                  armijoCoeff;
-        double                  contractionCoeff;
-        
-        const Eigen::VectorXd * initParameters;
-        const Eigen::VectorXd * direction;
-        double                  armijoLineIntercept;
-        double                  armijoLineSlope;
-        unsigned int            numIterations;        
+        LineSearchBackTrackPolicy<Function<Dim>> policy;
 };
 
+template <class Objective>
+LineSearchBackTrackPolicy<Objective>::LineSearchBackTrackPolicy(Objective &        objFunc,
+                                                                const double       armijoCoeff,
+                                                                const double       contractionCoeff,
+                                                                const unsigned int maxNumIterations)
+                                                                :
+                                                                restriction(objFunc)
+{
+    setMaxNumIterations(maxNumIterations);
+    setCoefficients(armijoCoeff, contractionCoeff);
+}
+
+/*
+ *  Implements line search Algorithm 3.1 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 37
+ */
+
+template <class Objective>
+bool LineSearchBackTrackPolicy<Objective>::search(const Vector & initParameters,
+                                                  const Vector & initGradient,
+                                                  const Vector & direction,
+                                                  Vector &       parameters,
+                                                  double &       funcValue,
+                                                  Vector &       gradient,
+                                                  double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    const double initGradDotDir = initGradient.dot(direction);
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradDotDir)
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    restriction.setLine(initParameters, funcValue, initGradient, direction);
+
+    this->armijoLineIntercept = funcValue;
+    this->armijoLineSlope     = armijoCoeff * initGradDotDir;
+    this->numIterations       = 0;
+
+    while (true)
+    {
+        ++numIterations;
+
+        if (stepLength < DBL_EPSILON)
+        {
+            // Current step length is too small.
+            return false;
+        }
+
+        evalFunc(stepLength, funcValue);
+        if (checkArmijo(stepLength, funcValue))
+        {
+            restriction.calcGrad(stepLength, parameters, gradient);
+            return true;
+        }
+
+        // Decrease step length in exponential fashion.
+        stepLength = contractionCoeff * stepLength;
+
+        if (numIterations >= maxNumIterations)
+        {
+            return false;
+        }
+    }
+}
+
+template <class Objective>
+void LineSearchBackTrackPolicy<Objective>::setCoefficients(double armijoCoeff, double contractionCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+
+    if (contractionCoeff <= 0.0 || contractionCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The contraction coefficient must be in (0, 1).");
+    }
+
+    this->armijoCoeff = armijoCoeff;
+    this->contractionCoeff  = contractionCoeff;
+}
+
+template <class Objective>
+double LineSearchBackTrackPolicy<Objective>::getArmijoCoeff() const
+{
+    return armijoCoeff;
+}
+
+template <class Objective>
+double LineSearchBackTrackPolicy<Objective>::getContractionCoeff() const
+{
+    return contractionCoeff;
+}
+
+template <class Objective>
+void LineSearchBackTrackPolicy<Objective>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective>
+unsigned int LineSearchBackTrackPolicy<Objective>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+LineSearchBackTrack<Dim>::LineSearchBackTrack(Function<Dim> &    objFunc,
+                                              const double       armijoCoeff,
+                                              const double       contractionCoeff,
+                                              const unsigned int maxNumIterations)
+                                              :
+                                              LineSearch<Dim>(objFunc,
+                                                              maxNumIterations),
+                                              policy(objFunc,
+                                                     armijoCoeff,
+                                                     contractionCoeff,
+                                                     maxNumIterations)
+{
+
+}
+
+template <int Dim>
+LineSearchBackTrack<Dim>::~LineSearchBackTrack()
+{
+
+}
+
+extern template class LineSearchBackTrackPolicy<Function<Eigen::Dynamic>>;
+extern template class LineSearchBackTrack<Eigen::Dynamic>;
+
 }
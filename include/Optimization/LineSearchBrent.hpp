@@ -0,0 +1,517 @@
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/LineSearch.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search policy for StaticSolver minimizing the restriction of the objective function
+ *  to the search line with Brent's method, i.e. parabolic interpolation safeguarded by
+ *  golden section steps. It only uses function values, and the gradient is computed once at
+ *  the accepted step. This pays off when the gradient is approximated with n + 1 function
+ *  evaluations. Brent's method only runs if the bracketing had to extrapolate the trial
+ *  step or the bracketed step does not satisfy the Armijo condition.
+ */
+
+template <class Objective>
+class LineSearchBrentPolicy
+{
+    public:
+        typedef typename Objective::Vector                   Vector;
+        typedef typename LineRestrictionOf<Objective>::Type Restriction;
+
+    public:
+        LineSearchBrentPolicy(Objective &        objFunc,
+                              const double       armijoCoeff = 1e-4,
+                              const double       tolerance = 1e-1,
+                              const unsigned int maxNumIterations = 1000);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+        /*
+         *  The coefficient of the Armijo condition, which the accepted step must satisfy.
+         *  The armijoCoeff must be in (0, 1). The default value is 1e-4.
+         */
+
+        void setArmijoCoeff(double armijoCoeff);
+        double getArmijoCoeff() const;
+
+        /*
+         *  The relative tolerance of the minimizing step length.
+         *  The tolerance must be in (0, 1). The default value is 1e-1, since the
+         *  line search only needs a rough minimizer.
+         */
+
+        void setTolerance(double tolerance);
+        double getTolerance() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+    private:
+        bool bracket(double & stepLengthLow,
+                     double & stepLength,
+                     double & funcValue,
+                     double & stepLengthHigh);
+
+        bool minimize(double   stepLengthLow,
+                      double & stepLength,
+                      double & funcValue,
+                      double   stepLengthHigh);
+
+        inline bool evalFunc(double   stepLength,
+                             double & funcValue)
+        {
+            ++numIterations;
+
+            funcValue = restriction.calcValue(stepLength);
+
+            return numIterations <= maxNumIterations;
+        }
+
+        inline bool checkArmijo(double stepLength,
+                                double funcValue) const
+        {
+            // Check the Armijo os sufficient decrease condition.
+            return funcValue <= (armijoLineIntercept + stepLength * armijoLineSlope);
+        }
+
+    private:
+        Restriction    restriction;
+        unsigned int   maxNumIterations;
+
+        double         armijoCoeff;
+        double         tolerance;
+
+        double         armijoLineIntercept;
+        double         armijoLineSlope;
+        unsigned int   numIterations;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchBrentPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchBrent : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchBrent(Function<Dim> &    objFunc,
+                        const double       armijoCoeff = 1e-4,
+                        const double       tolerance = 1e-1,
+                        const unsigned int maxNumIterations = 1000);
+
+        ~LineSearchBrent();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            policy.setMaxNumIterations(this->maxNumIterations);
+
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+        inline void setArmijoCoeff(double armijoCoeff)
+        {
+            policy.setArmijoCoeff(armijoCoeff);
+        }
+
+        inline double getArmijoCoeff() const
+        {
+            return policy.getArmijoCoeff();
+        }
+
+        inline void setTolerance(double tolerance)
+        {
+            policy.setTolerance(tolerance);
+        }
+
+        inline double getTolerance() const
+        {
+            return policy.getTolerance();
+        }
+
+    private:
+        LineSearchBrentPolicy<Function<Dim>> policy;
+};
+
+template <class Objective>
+LineSearchBrentPolicy<Objective>::LineSearchBrentPolicy(Objective &        objFunc,
+                                                        const double       armijoCoeff,
+                                                        const double       tolerance,
+                                                        const unsigned int maxNumIterations)
+                                                        :
+                                                        restriction(objFunc)
+{
+    setMaxNumIterations(maxNumIterations);
+    setArmijoCoeff(armijoCoeff);
+    setTolerance(tolerance);
+}
+
+template <class Objective>
+bool LineSearchBrentPolicy<Objective>::search(const Vector & initParameters,
+                                              const Vector & initGradient,
+                                              const Vector & direction,
+                                              Vector &       parameters,
+                                              double &       funcValue,
+                                              Vector &       gradient,
+                                              double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    const double initGradDotDir = initGradient.dot(direction);
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradDotDir)
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    restriction.setLine(initParameters, funcValue, initGradient, direction);
+
+    this->armijoLineIntercept = funcValue;
+    this->armijoLineSlope     = armijoCoeff * initGradDotDir;
+    this->numIterations       = 0;
+
+    double stepLengthLow;
+    double stepLengthHigh;
+
+    if (!bracket(stepLengthLow, stepLength, funcValue, stepLengthHigh))
+    {
+        return false;
+    }
+
+    // A trial step that was not extrapolated already bounds the minimizer by twice its
+    // length. If it decreases the function sufficiently, refining it is not worth the
+    // function evaluations.
+    if ((stepLengthLow > 0.0 || !checkArmijo(stepLength, funcValue)) &&
+        !minimize(stepLengthLow, stepLength, funcValue, stepLengthHigh))
+    {
+        return false;
+    }
+
+    if (!checkArmijo(stepLength, funcValue))
+    {
+        // The minimizer on the line does not decrease the function sufficiently.
+        return false;
+    }
+
+    restriction.calcGrad(stepLength, parameters, gradient);
+
+    return true;
+}
+
+/*
+ *  Brackets a minimizer of the function on the line, such that the function value at
+ *  stepLength is smaller than at stepLengthLow and stepLengthHigh. The initial step length
+ *  is doubled as long as the function decreases, otherwise halved until the function value
+ *  drops below the initial one.
+ */
+
+template <class Objective>
+bool LineSearchBrentPolicy<Objective>::bracket(double & stepLengthLow,
+                                               double & stepLength,
+                                               double & funcValue,
+                                               double & stepLengthHigh)
+{
+    const double initFuncValue = funcValue;
+
+    stepLengthLow = 0.0;
+    if (!evalFunc(stepLength, funcValue))
+    {
+        return false;
+    }
+
+    if (funcValue < initFuncValue)
+    {
+        // Extrapolate step length in exponential fashion.
+        while (true)
+        {
+            stepLengthHigh = 2.0 * stepLength;
+            if (std::isinf(stepLengthHigh))
+            {
+                // Reached maximum possible step length.
+                return false;
+            }
+
+            double funcValueHigh;
+            if (!evalFunc(stepLengthHigh, funcValueHigh))
+            {
+                return false;
+            }
+
+            if (funcValueHigh >= funcValue)
+            {
+                return true;
+            }
+
+            stepLengthLow = stepLength;
+            stepLength    = stepLengthHigh;
+            funcValue     = funcValueHigh;
+        }
+    }
+    else
+    {
+        // Decrease step length in exponential fashion.
+        while (true)
+        {
+            stepLengthHigh = stepLength;
+            stepLength     = 0.5 * stepLength;
+            if (stepLength < DBL_EPSILON)
+            {
+                // Current step length is too small.
+                return false;
+            }
+
+            if (!evalFunc(stepLength, funcValue))
+            {
+                return false;
+            }
+
+            if (funcValue < initFuncValue)
+            {
+                return true;
+            }
+        }
+    }
+}
+
+/*
+ *  Implements Brent's method for one-dimensional minimization from
+ *  Richard P. Brent, Algorithms for Minimization without Derivatives,
+ *  Prentice-Hall, 1973, Chapter 5
+ *  starting from the bracket (stepLengthLow, stepLength, stepLengthHigh).
+ */
+
+template <class Objective>
+bool LineSearchBrentPolicy<Objective>::minimize(double   stepLengthLow,
+                                                double & stepLength,
+                                                double & funcValue,
+                                                double   stepLengthHigh)
+{
+    // Square of the inverse golden ratio.
+    const double goldenCoeff = 0.5 * (3.0 - std::sqrt(5.0));
+
+    // Best, second best and previous second best points.
+    double x  = stepLength;
+    double w  = stepLength;
+    double v  = stepLength;
+    double fx = funcValue;
+    double fw = funcValue;
+    double fv = funcValue;
+
+    // Current and previous steps.
+    double d = 0.0;
+    double e = 0.0;
+
+    while (true)
+    {
+        const double middle     = 0.5 * (stepLengthLow + stepLengthHigh);
+        const double tolerance1 = tolerance * std::fabs(x) + DBL_EPSILON;
+        const double tolerance2 = 2.0 * tolerance1;
+
+        if (std::fabs(x - middle) <= tolerance2 - 0.5 * (stepLengthHigh - stepLengthLow))
+        {
+            // Bracket is small enough.
+            break;
+        }
+
+        bool goldenSection = true;
+        if (std::fabs(e) > tolerance1)
+        {
+            // Fit a parabola through x, w and v.
+            const double r = (x - w) * (fx - fv);
+            double       q = (x - v) * (fx - fw);
+            double       p = (x - v) * q - (x - w) * r;
+            q = 2.0 * (q - r);
+            if (q > 0.0)
+            {
+                p = -p;
+            }
+            q = std::fabs(q);
+
+            // Accept the parabolic step if it falls into the bracket and is smaller than
+            // half of the step before last.
+            if (std::fabs(p) < std::fabs(0.5 * q * e) &&
+                p > q * (stepLengthLow - x) &&
+                p < q * (stepLengthHigh - x))
+            {
+                e = d;
+                d = p / q;
+                goldenSection = false;
+
+                // The function must not be evaluated too close to the bracket ends.
+                const double u = x + d;
+                if (u - stepLengthLow < tolerance2 || stepLengthHigh - u < tolerance2)
+                {
+                    d = (middle > x) ? tolerance1 : -tolerance1;
+                }
+            }
+        }
+
+        if (goldenSection)
+        {
+            // Golden section step into the larger part of the bracket.
+            e = (x >= middle) ? (stepLengthLow - x) : (stepLengthHigh - x);
+            d = goldenCoeff * e;
+        }
+
+        // The function must not be evaluated too close to x.
+        const double u = (std::fabs(d) >= tolerance1) ? (x + d) : (x + ((d > 0.0) ? tolerance1 : -tolerance1));
+
+        double fu;
+        if (!evalFunc(u, fu))
+        {
+            // Reached maximum number of allowed iteration.
+            return false;
+        }
+
+        if (fu <= fx)
+        {
+            if (u >= x)
+            {
+                stepLengthLow = x;
+            }
+            else
+            {
+                stepLengthHigh = x;
+            }
+
+            v  = w;
+            fv = fw;
+            w  = x;
+            fw = fx;
+            x  = u;
+            fx = fu;
+        }
+        else
+        {
+            if (u < x)
+            {
+                stepLengthLow = u;
+            }
+            else
+            {
+                stepLengthHigh = u;
+            }
+
+            if (fu <= fw || w == x)
+            {
+                v  = w;
+                fv = fw;
+                w  = u;
+                fw = fu;
+            }
+            else if (fu <= fv || v == x || v == w)
+            {
+                v  = u;
+                fv = fu;
+            }
+        }
+    }
+
+    stepLength = x;
+    funcValue  = fx;
+
+    return true;
+}
+
+template <class Objective>
+void LineSearchBrentPolicy<Objective>::setArmijoCoeff(double armijoCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+    this->armijoCoeff = armijoCoeff;
+}
+
+template <class Objective>
+double LineSearchBrentPolicy<Objective>::getArmijoCoeff() const
+{
+    return armijoCoeff;
+}
+
+template <class Objective>
+void LineSearchBrentPolicy<Objective>::setTolerance(double tolerance)
+{
+    if (tolerance <= 0.0 || tolerance >= 1.0)
+    {
+        throw std::invalid_argument("The tolerance must be in (0, 1).");
+    }
+    this->tolerance = tolerance;
+}
+
+template <class Objective>
+double LineSearchBrentPolicy<Objective>::getTolerance() const
+{
+    return tolerance;
+}
+
+template <class Objective>
+void LineSearchBrentPolicy<Objective>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective>
+unsigned int LineSearchBrentPolicy<Objective>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+LineSearchBrent<Dim>::LineSearchBrent(Function<Dim> &    objFunc,
+                                      const double       armijoCoeff,
+                                      const double       tolerance,
+                                      const unsigned int maxNumIterations)
+                                      :
+                                      LineSearch<Dim>(objFunc,
+                                                      maxNumIterations),
+                                      policy(objFunc,
+                                             armijoCoeff,
+                                             tolerance,
+                                             maxNumIterations)
+{
+
+}
+
+template <int Dim>
+LineSearchBrent<Dim>::~LineSearchBrent()
+{
+
+}
+
+extern template class LineSearchBrentPolicy<Function<Eigen::Dynamic>>;
+extern template class LineSearchBrent<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/LineSearch.hpp>
+#include <Optimization/QuadraticFunction.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search policy for StaticSolver, which minimizes the objective function along the
+ *  direction exactly. The line restriction of the objective function must provide the
+ *  minimizer in closed form through calcMinimizer and the function value at a point of the
+ *  line through calcFuncValue, as QuadraticLineRestriction does.
+ */
+
+template <class Objective>
+class LineSearchExactPolicy
+{
+    public:
+        typedef typename Objective::Vector                   Vector;
+        typedef typename LineRestrictionOf<Objective>::Type Restriction;
+
+    public:
+        LineSearchExactPolicy(Objective & objFunc);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+    private:
+        Restriction restriction;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchExactPolicy. It is the default line search of the
+ *  solvers for a QuadraticFunction.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchExact : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchExact(QuadraticFunction<Dim> & objFunc);
+
+        ~LineSearchExact();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+    private:
+        LineSearchExactPolicy<QuadraticFunction<Dim>> policy;
+};
+
+template <class Objective>
+LineSearchExactPolicy<Objective>::LineSearchExactPolicy(Objective & objFunc)
+:
+restriction(objFunc)
+{
+
+}
+
+/*
+ *  The initial step length is ignored. The search fails if the objective function is not
+ *  bounded below along the direction.
+ */
+
+template <class Objective>
+bool LineSearchExactPolicy<Objective>::search(const Vector & initParameters,
+                                              const Vector & initGradient,
+                                              const Vector & direction,
+                                              Vector &       parameters,
+                                              double &       funcValue,
+                                              Vector &       gradient,
+                                              double &       stepLength)
+{
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradient.dot(direction))
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    restriction.setLine(initParameters, funcValue, initGradient, direction);
+
+    if (!restriction.calcMinimizer(stepLength) || stepLength <= 0.0)
+    {
+        return false;
+    }
+
+    // The function value is recomputed at the accepted point rather than taken from phi,
+    // which would carry the rounding errors of all previous searches.
+    restriction.calcGrad(stepLength, parameters, gradient);
+    funcValue = restriction.calcFuncValue(parameters, gradient);
+
+    return true;
+}
+
+template <int Dim>
+LineSearchExact<Dim>::LineSearchExact(QuadraticFunction<Dim> & objFunc)
+:
+LineSearch<Dim>(objFunc, 1),
+policy(objFunc)
+{
+
+}
+
+template <int Dim>
+LineSearchExact<Dim>::~LineSearchExact()
+{
+
+}
+
+extern template class LineSearchExactPolicy<QuadraticFunction<Eigen::Dynamic>>;
+extern template class LineSearchExact<Eigen::Dynamic>;
+
+}
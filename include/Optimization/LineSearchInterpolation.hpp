@@ -0,0 +1,310 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/LineSearch.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search policy for StaticSolver. Like LineSearchBackTrackPolicy it decreases the step
+ *  length until the Armijo condition holds, but the next trial step length minimizes an
+ *  interpolating model of phi instead of being a fixed fraction of the current one. The
+ *  models only use phi(0), phi'(0) and the values at the previous trial step lengths, hence
+ *  they need no additional evaluations.
+ */
+
+template <class Objective>
+class LineSearchInterpolationPolicy
+{
+    public:
+        typedef typename Objective::Vector                   Vector;
+        typedef typename LineRestrictionOf<Objective>::Type Restriction;
+
+    public:
+        LineSearchInterpolationPolicy(Objective &        objFunc,
+                                      const double       armijoCoeff = 1e-4,
+                                      const unsigned int maxNumIterations = 1000);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+        void setArmijoCoeff(double armijoCoeff);
+        double getArmijoCoeff() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+    private:
+        inline bool checkArmijo(double stepLength,
+                                double funcValue) const
+        {
+            // Check the Armijo os sufficient decrease condition.
+            return funcValue <= (initFuncValue + stepLength * armijoCoeff * initGradDotDir);
+        }
+
+        double interpolateQuadratic(double stepLength,
+                                    double funcValue) const;
+
+        double interpolateCubic(double stepLength,
+                                double funcValue,
+                                double lastStepLength,
+                                double lastFuncValue) const;
+
+    private:
+        Restriction    restriction;
+        unsigned int   maxNumIterations;
+
+        double         armijoCoeff;
+
+        double         initFuncValue;
+        double         initGradDotDir;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchInterpolationPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchInterpolation : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchInterpolation(Function<Dim> &    objFunc,
+                                const double       armijoCoeff = 1e-4,
+                                const unsigned int maxNumIterations = 1000);
+
+        ~LineSearchInterpolation();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            policy.setMaxNumIterations(this->maxNumIterations);
+
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+        inline void setArmijoCoeff(double armijoCoeff)
+        {
+            policy.setArmijoCoeff(armijoCoeff);
+        }
+
+        inline double getArmijoCoeff() const
+        {
+            return policy.getArmijoCoeff();
+        }
+
+    private:
+        LineSearchInterpolationPolicy<Function<Dim>> policy;
+};
+
+template <class Objective>
+LineSearchInterpolationPolicy<Objective>::LineSearchInterpolationPolicy(Objective &        objFunc,
+                                                                        const double       armijoCoeff,
+                                                                        const unsigned int maxNumIterations)
+                                                                        :
+                                                                        restriction(objFunc)
+{
+    setMaxNumIterations(maxNumIterations);
+    setArmijoCoeff(armijoCoeff);
+}
+
+/*
+ *  Implements the interpolation procedure of Section 3.5 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Pages 57-58
+ *
+ *  The first backtrack minimizes the quadratic interpolating phi(0), phi'(0) and
+ *  phi(stepLength), every further one the cubic interpolating phi(0), phi'(0) and the last
+ *  two trial values. The new step length is safeguarded to [0.1, 0.5] times the current one.
+ */
+
+template <class Objective>
+bool LineSearchInterpolationPolicy<Objective>::search(const Vector & initParameters,
+                                                      const Vector & initGradient,
+                                                      const Vector & direction,
+                                                      Vector &       parameters,
+                                                      double &       funcValue,
+                                                      Vector &       gradient,
+                                                      double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    this->initGradDotDir = initGradient.dot(direction);
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradDotDir)
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    restriction.setLine(initParameters, funcValue, initGradient, direction);
+
+    this->initFuncValue = funcValue;
+
+    double lastStepLength = 0.0;
+    double lastFuncValue  = 0.0;
+
+    for (unsigned int numIterations = 1; ; ++numIterations)
+    {
+        if (stepLength < DBL_EPSILON)
+        {
+            // Current step length is too small.
+            return false;
+        }
+
+        funcValue = restriction.calcValue(stepLength);
+        if (checkArmijo(stepLength, funcValue))
+        {
+            restriction.calcGrad(stepLength, parameters, gradient);
+            return true;
+        }
+
+        if (numIterations >= maxNumIterations)
+        {
+            return false;
+        }
+
+        double nextStepLength;
+        if (numIterations == 1)
+        {
+            nextStepLength = interpolateQuadratic(stepLength, funcValue);
+        }
+        else
+        {
+            nextStepLength = interpolateCubic(stepLength, funcValue, lastStepLength, lastFuncValue);
+        }
+
+        // Safeguard the step length, which also rejects a failed interpolation.
+        if (!std::isfinite(nextStepLength) || nextStepLength > 0.5 * stepLength)
+        {
+            nextStepLength = 0.5 * stepLength;
+        }
+        else if (nextStepLength < 0.1 * stepLength)
+        {
+            nextStepLength = 0.1 * stepLength;
+        }
+
+        lastStepLength = stepLength;
+        lastFuncValue  = funcValue;
+        stepLength     = nextStepLength;
+    }
+}
+
+/*
+ *  Minimizer of the quadratic (3.57).
+ */
+
+template <class Objective>
+double LineSearchInterpolationPolicy<Objective>::interpolateQuadratic(double stepLength,
+                                                                      double funcValue) const
+{
+    return -initGradDotDir * stepLength * stepLength / (2 * (funcValue - initFuncValue - initGradDotDir * stepLength));
+}
+
+/*
+ *  Minimizer (3.59) of the cubic (3.58).
+ */
+
+template <class Objective>
+double LineSearchInterpolationPolicy<Objective>::interpolateCubic(double stepLength,
+                                                                  double funcValue,
+                                                                  double lastStepLength,
+                                                                  double lastFuncValue) const
+{
+    const double residual     = funcValue - initFuncValue - initGradDotDir * stepLength;
+    const double lastResidual = lastFuncValue - initFuncValue - initGradDotDir * lastStepLength;
+
+    const double stepLengthSquared     = stepLength * stepLength;
+    const double lastStepLengthSquared = lastStepLength * lastStepLength;
+    const double denominator = lastStepLengthSquared * stepLengthSquared * (stepLength - lastStepLength);
+
+    const double a = (lastStepLengthSquared * residual - stepLengthSquared * lastResidual) / denominator;
+    const double b = (-lastStepLengthSquared * lastStepLength * residual + stepLengthSquared * stepLength * lastResidual) / denominator;
+
+    if (a == 0.0)
+    {
+        // The cubic degenerates to a quadratic.
+        return -initGradDotDir / (2 * b);
+    }
+
+    return (-b + std::sqrt(b * b - 3 * a * initGradDotDir)) / (3 * a);
+}
+
+template <class Objective>
+void LineSearchInterpolationPolicy<Objective>::setArmijoCoeff(double armijoCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+
+    this->armijoCoeff = armijoCoeff;
+}
+
+template <class Objective>
+double LineSearchInterpolationPolicy<Objective>::getArmijoCoeff() const
+{
+    return armijoCoeff;
+}
+
+template <class Objective>
+void LineSearchInterpolationPolicy<Objective>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective>
+unsigned int LineSearchInterpolationPolicy<Objective>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+LineSearchInterpolation<Dim>::LineSearchInterpolation(Function<Dim> &    objFunc,
+                                                      const double       armijoCoeff,
+                                                      const unsigned int maxNumIterations)
+                                                      :
+                                                      LineSearch<Dim>(objFunc,
+                                                                      maxNumIterations),
+                                                      policy(objFunc,
+                                                             armijoCoeff,
+                                                             maxNumIterations)
+{
+
+}
+
+template <int Dim>
+LineSearchInterpolation<Dim>::~LineSearchInterpolation()
+{
+
+}
+
+extern template class LineSearchInterpolationPolicy<Function<Eigen::Dynamic>>;
+extern template class LineSearchInterpolation<Eigen::Dynamic>;
+
+}
@@ -1,94 +1,434 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
 #include <Eigen/Dense>
 #include <Optimization/LineSearch.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class LineSearchNocedal : public LineSearch 
+/*
+ *  Line search policy for StaticSolver. The objective function type is a template
+ *  parameter, hence its calls are resolved at compile time and may be inlined.
+ */
+
+template <class Objective>
+class LineSearchNocedalPolicy
 {
     public:
-        LineSearchNocedal(Function &         objFunc,
-                          const double       armijoCoeff = 1e-4,
-                          const double       wolfeCoeff = 0.9,
-                          const unsigned int maxNumIterations = 1000);
-        
-        ~LineSearchNocedal();
-        
-        bool search(const Eigen::VectorXd & lastParameters,
-                    const Eigen::VectorXd & lastGradient,
-                    const Eigen::VectorXd & direction,
-                    Eigen::VectorXd &       parameters,
-                    double &                funcValue,
-                    Eigen::VectorXd &       gradient,
-                    double &                stepLength) override;
-        
-        /* 
+        typedef typename Objective::Vector                   Vector;
+        typedef typename LineRestrictionOf<Objective>::Type Restriction;
+
+    public:
+        LineSearchNocedalPolicy(Objective &        objFunc,
+                                const double       armijoCoeff = 1e-4,
+                                const double       wolfeCoeff = 0.9,
+                                const unsigned int maxNumIterations = 1000);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+        /*
          *  Set the coefficients for the Armijo and Wolfe conditions.
          *  The armijoCoeff must be in (0, 1). The default value is 1e-4.
          *  The wolfeCoeff must be in (armijoCoeff, 1). The default value is 0.9.
          */
-        
-        void setCoefficients(double armijoCoeff, 
+
+        void setCoefficients(double armijoCoeff,
                              double wolfeCoeff);
         double getArmijoCoeff() const;
         double getWolfeCoeff() const;
-        
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        /*
+         *  The largest step length tried, e.g. the last one keeping the parameters inside of
+         *  their bounds. A step of this length that satisfies the Armijo condition while the
+         *  function is still decreasing is accepted without the curvature condition. The
+         *  default value is infinity.
+         */
+
+        void setMaxStepLength(double maxStepLength);
+        double getMaxStepLength() const;
+
     private:
-        bool zoom(double            stepLengthLow,
-                  double            stepLengthHigh,
-                  double            funcValueLow,
-                  Eigen::VectorXd & parameters,
-                  double &          funcValue,
-                  Eigen::VectorXd & gradient,
-                  double &          stepLength);
-
-        inline void evalFunc(double & stepLength,
-                             Eigen::VectorXd & parameters,
+        bool zoom(double   stepLengthLow,
+                  double   stepLengthHigh,
+                  double   funcValueLow,
+                  Vector & parameters,
+                  double & funcValue,
+                  Vector & gradient,
+                  double & stepLength);
+
+        inline void evalFunc(double   stepLength,
                              double & funcValue)
         {
-            parameters = (*initParameters) + stepLength * (*direction);
-            objFunc->calcObjFuncValue(parameters, funcValue);
+            funcValue = restriction.calcValue(stepLength);
 
             return;
         }
 
-        inline double evalGrad(double &          stepLength,
-                               Eigen::VectorXd & parameters,
-                               Eigen::VectorXd & gradient) const 
+        inline double evalGrad(double stepLength,
+                               double funcValue,
+                               bool   fullGrad = true)
         {
-            parameters = (*initParameters) + stepLength * (*direction);
-            objFunc->calcGrad(parameters, gradient);
-            const double gradDotDir = gradient.dot(*direction);
-            
-            return gradDotDir;
+            // Without an exact gradient, the directional derivative is approximated first
+            // and the full gradient is only computed when the trial step may be accepted.
+            if (!fullGrad)
+            {
+                const double gradDotDir = restriction.calcDerivative(stepLength, funcValue, true);
+                if (!checkStrongWolfe(gradDotDir))
+                {
+                    return gradDotDir;
+                }
+            }
+
+            return restriction.calcDerivative(stepLength, funcValue);
         }
-        
+
         inline bool checkArmijo(double stepLength,
-                                double funcValue) const 
+                                double funcValue) const
         {
             // Check the Armijo os sufficient decrease condition.
             return funcValue <= (armijoLineIntercept + stepLength * armijoLineSlope);
         }
-        
-        inline bool checkStrongWolfe(double gradDotDir) const 
+
+        inline bool checkStrongWolfe(double gradDotDir) const
         {
             // Check the Wolfe or curvature condition.
             return std::fabs(gradDotDir) <= strongWolfeRHS;
         }
-        
+
+    private:
+        Restriction    restriction;
+        unsigned int   maxNumIterations;
+        double         maxStepLength;
+
+        double         armijoCoeff;
+        double         wolfeCoeff;
+
+        double         armijoLineIntercept;
+        double         armijoLineSlope;
+        double         strongWolfeRHS;
+        unsigned int   numIterations;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchNocedalPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchNocedal : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchNocedal(Function<Dim> &    objFunc,
+                          const double       armijoCoeff = 1e-4,
+                          const double       wolfeCoeff = 0.9,
+                          const unsigned int maxNumIterations = 1000);
+
+        ~LineSearchNocedal();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            policy.setMaxNumIterations(this->maxNumIterations);
+
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+        /*
+         *  Set the coefficients for the Armijo and Wolfe conditions.
+         *  The armijoCoeff must be in (0, 1). The default value is 1e-4.
+         *  The wolfeCoeff must be in (armijoCoeff, 1). The default value is 0.9.
+         */
+
+        inline void setCoefficients(double armijoCoeff,
+                                    double wolfeCoeff)
+        {
+            policy.setCoefficients(armijoCoeff, wolfeCoeff);
+        }
+
+        inline double getArmijoCoeff() const
+        {
+            return policy.getArmijoCoeff();
+        }
+
+        inline double getWolfeCoeff() const
+        {
+            return policy.getWolfeCoeff();
+        }
+
     private:
-        double                  armijoCoeff;
-        double                  wolfeCoeff;
-        
-        const Eigen::VectorXd * initParameters;
-        const Eigen::VectorXd * direction;
-        double                  armijoLineIntercept;
-        double                  armijoLineSlope;
-        double                  strongWolfeRHS;
-        unsigned int            numIterations;        
+        LineSearchNocedalPolicy<Function<Dim>> policy;
 };
 
+template <class Objective>
+LineSearchNocedalPolicy<Objective>::LineSearchNocedalPolicy(Objective &        objFunc,
+                                                            const double       armijoCoeff,
+                                                            const double       wolfeCoeff,
+                                                            const unsigned int maxNumIterations)
+                                                            :
+                                                            restriction(objFunc),
+                                                            maxStepLength(std::numeric_limits<double>::infinity()),
+                                                            armijoLineIntercept(0.0),
+                                                            armijoLineSlope(0.0),
+                                                            strongWolfeRHS(0.0),
+                                                            numIterations(0)
+{
+    setMaxNumIterations(maxNumIterations);
+    setCoefficients(armijoCoeff, wolfeCoeff);
+}
+
+/*
+ *  Implements line search Algorithm 3.5 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 60
+ */
+
+template <class Objective>
+bool LineSearchNocedalPolicy<Objective>::search(const Vector & initParameters,
+                                                const Vector & initGradient,
+                                                const Vector & direction,
+                                                Vector &       parameters,
+                                                double &       funcValue,
+                                                Vector &       gradient,
+                                                double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    stepLength = std::min(stepLength, maxStepLength);
+
+    const double initGradDotDir = initGradient.dot(direction);
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradDotDir)
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    restriction.setLine(initParameters, funcValue, initGradient, direction);
+
+    this->armijoLineIntercept = funcValue;
+    this->armijoLineSlope     = armijoCoeff * initGradDotDir;
+    this->strongWolfeRHS      = -wolfeCoeff * initGradDotDir;
+    this->numIterations       = 0;
+
+    double lastStepLength = 0.0;
+    double lastFuncValue  = armijoLineIntercept;
+
+    while (true)
+    {
+        evalFunc(stepLength, funcValue);
+        if (!checkArmijo(stepLength, funcValue) || funcValue >= lastFuncValue)
+        {
+            return zoom(lastStepLength, stepLength, lastFuncValue, parameters, funcValue, gradient, stepLength);
+        }
+
+        // The initial trial step is usually accepted, hence its full gradient is computed
+        // right away.
+        const double gradDotDir = evalGrad(stepLength, funcValue, lastStepLength == 0.0);
+        if (checkStrongWolfe(gradDotDir))
+        {
+            // Line search was successful.
+            restriction.calcGrad(stepLength, parameters, gradient);
+            return true;
+        }
+
+        if (gradDotDir >= 0.0)
+        {
+            return zoom(stepLength, lastStepLength, funcValue, parameters, funcValue, gradient, stepLength);
+        }
+
+        if (stepLength >= maxStepLength)
+        {
+            // The function decreases up to the largest step length.
+            restriction.calcGrad(stepLength, parameters, gradient);
+            return true;
+        }
+
+        lastStepLength = stepLength;
+        lastFuncValue  = funcValue;
+
+        // Extrapolate step length in exponential fashion.
+        stepLength = std::min(2.0 * stepLength, maxStepLength);
+
+        if (std::isinf(stepLength))
+        {
+            // Reached maximum possible step length.
+            return false;
+        }
+    }
+}
+
+/*
+ *  Implements line search zoom Algorithm 3.6 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 61
+ */
+
+template <class Objective>
+bool LineSearchNocedalPolicy<Objective>::zoom(double   stepLengthLow,
+                                              double   stepLengthHigh,
+                                              double   funcValueLow,
+                                              Vector & parameters,
+                                              double & funcValue,
+                                              Vector & gradient,
+                                              double & stepLength)
+{
+    while (true)
+    {
+        ++numIterations;
+
+        // Length of the bracketed interval is too small. More specifically, it is smaller
+        // than the increment used in forward difference.
+        if (std::fabs(stepLengthHigh - stepLengthLow) < DBL_EPSILON)
+        {
+            return false;
+        }
+
+        // Bisect current step length interval.
+        stepLength = 0.5 * (stepLengthLow + stepLengthHigh);
+
+        evalFunc(stepLength, funcValue);
+        if (!checkArmijo(stepLength, funcValue) || funcValue >= funcValueLow)
+        {
+            // Change upper bound.
+            stepLengthHigh = stepLength;
+        }
+        else
+        {
+            const double gradDotDir = evalGrad(stepLength, funcValue, false);
+            if (checkStrongWolfe(gradDotDir))
+            {
+                // Line search was successful.
+                restriction.calcGrad(stepLength, parameters, gradient);
+                return true;
+            }
+            if (gradDotDir * (stepLengthHigh - stepLengthLow) >= 0)
+            {
+                // Change upper bound.
+                stepLengthHigh = stepLengthLow;
+            }
+            // Change lower bound.
+            stepLengthLow = stepLength;
+            funcValueLow  = funcValue;
+        }
+        if (numIterations > maxNumIterations)
+        {
+            // Reached maximum number of allowed iteration.
+            return false;
+        }
+    }
+}
+
+template <class Objective>
+void LineSearchNocedalPolicy<Objective>::setCoefficients(double armijoCoeff,
+                                                         double wolfeCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+
+    if (wolfeCoeff <= armijoCoeff || wolfeCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Wolfe coefficient must be in (armijoCoeff, 1).");
+    }
+
+    this->armijoCoeff = armijoCoeff;
+    this->wolfeCoeff  = wolfeCoeff;
+}
+
+template <class Objective>
+double LineSearchNocedalPolicy<Objective>::getArmijoCoeff() const
+{
+    return armijoCoeff;
+}
+
+template <class Objective>
+double LineSearchNocedalPolicy<Objective>::getWolfeCoeff() const
+{
+    return wolfeCoeff;
+}
+
+template <class Objective>
+void LineSearchNocedalPolicy<Objective>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective>
+unsigned int LineSearchNocedalPolicy<Objective>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <class Objective>
+void LineSearchNocedalPolicy<Objective>::setMaxStepLength(double maxStepLength)
+{
+    if (maxStepLength <= 0.0)
+    {
+        throw std::invalid_argument("Maximum step length must be greater than zero.");
+    }
+    this->maxStepLength = maxStepLength;
+}
+
+template <class Objective>
+double LineSearchNocedalPolicy<Objective>::getMaxStepLength() const
+{
+    return maxStepLength;
+}
+
+template <int Dim>
+LineSearchNocedal<Dim>::LineSearchNocedal(Function<Dim> &    objFunc,
+                                          const double       armijoCoeff,
+                                          const double       wolfeCoeff,
+                                          const unsigned int maxNumIterations)
+                                          :
+                                          LineSearch<Dim>(objFunc,
+                                                          maxNumIterations),
+                                          policy(objFunc,
+                                                 armijoCoeff,
+                                                 wolfeCoeff,
+                                                 maxNumIterations)
+{
+
+}
+
+template <int Dim>
+LineSearchNocedal<Dim>::~LineSearchNocedal()
+{
+
+}
+
+extern template class LineSearchNocedalPolicy<Function<Eigen::Dynamic>>;
+extern template class LineSearchNocedal<Eigen::Dynamic>;
+
 }
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cfloat>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/Function.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Backtracking line search for F(x) = f(x) + l1Weight ||x||_1 which keeps every trial point
+ *  inside of an orthant, as needed by OWLQN. The trial point of the step length alpha is the
+ *  projection
+ *
+ *      x(alpha) = P(x + alpha d),   P(z)_i = z_i if sign(z_i) = orthant_i, 0 otherwise,
+ *
+ *  and is accepted if F(x(alpha)) <= F(x) + armijoCoeff * pseudoGradient^T (x(alpha) - x).
+ *  Coefficients and the maximum number of iterations are validated like those of
+ *  LineSearchBackTrackPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchOrthantBackTrack
+{
+    public:
+        typedef typename Function<Dim>::Vector Vector;
+
+    public:
+        LineSearchOrthantBackTrack(Function<Dim> &    objFunc,
+                                   const double       armijoCoeff = 1e-4,
+                                   const double       contractionCoeff = 0.5,
+                                   const unsigned int maxNumIterations = 1000);
+
+        /*
+         *  Searches from initParameters with the total function value initTotalFuncValue. On
+         *  success parameters, the smooth function value funcValue, the total function value
+         *  totalFuncValue and the smooth gradient hold the accepted point.
+         */
+
+        bool search(const Vector & initParameters,
+                    double         initTotalFuncValue,
+                    const Vector & pseudoGradient,
+                    const Vector & direction,
+                    const Vector & orthant,
+                    double         l1Weight,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    double &       totalFuncValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+        void setCoefficients(double armijoCoeff, double contractionCoeff);
+        double getArmijoCoeff() const;
+        double getContractionCoeff() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+    private:
+        struct Coefficients
+        {
+            double       armijoCoeff;
+            double       contractionCoeff;
+            unsigned int maxNumIterations;
+        };
+
+    private:
+        Function<Dim> * objFunc;
+        Coefficients    coefficients;
+};
+
+template <int Dim>
+LineSearchOrthantBackTrack<Dim>::LineSearchOrthantBackTrack(Function<Dim> &    objFunc,
+                                                            const double       armijoCoeff,
+                                                            const double       contractionCoeff,
+                                                            const unsigned int maxNumIterations)
+                                                            :
+                                                            objFunc(&objFunc)
+{
+    setMaxNumIterations(maxNumIterations);
+    setCoefficients(armijoCoeff, contractionCoeff);
+}
+
+/*
+ *  Implements the constrained line search of
+ *  Galen Andrew and Jianfeng Gao, Scalable Training of L1-Regularized Log-Linear Models,
+ *  Proceedings of the 24th International Conference on Machine Learning, 2007
+ *  with the backtracking of Algorithm 3.1 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 37
+ */
+
+template <int Dim>
+bool LineSearchOrthantBackTrack<Dim>::search(const Vector & initParameters,
+                                             double         initTotalFuncValue,
+                                             const Vector & pseudoGradient,
+                                             const Vector & direction,
+                                             const Vector & orthant,
+                                             double         l1Weight,
+                                             Vector &       parameters,
+                                             double &       funcValue,
+                                             double &       totalFuncValue,
+                                             Vector &       gradient,
+                                             double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < pseudoGradient.dot(direction))
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    unsigned int numIterations = 0;
+
+    while (true)
+    {
+        ++numIterations;
+
+        if (stepLength < DBL_EPSILON)
+        {
+            // Current step length is too small.
+            return false;
+        }
+
+        // Trial point projected onto the orthant.
+        parameters = initParameters + stepLength * direction;
+        parameters = (parameters.array() * orthant.array() > 0.0).select(parameters, 0.0);
+
+        objFunc->calcObjFuncValue(parameters, funcValue);
+        totalFuncValue = funcValue + l1Weight * parameters.template lpNorm<1>();
+
+        // Check the Armijo condition along the projected step.
+        if (totalFuncValue <= initTotalFuncValue + coefficients.armijoCoeff * pseudoGradient.dot(parameters - initParameters))
+        {
+            objFunc->calcGrad(parameters, gradient);
+            return true;
+        }
+
+        // Decrease step length in exponential fashion.
+        stepLength = coefficients.contractionCoeff * stepLength;
+
+        if (numIterations >= coefficients.maxNumIterations)
+        {
+            return false;
+        }
+    }
+}
+
+template <int Dim>
+void LineSearchOrthantBackTrack<Dim>::setCoefficients(double armijoCoeff, double contractionCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+
+    if (contractionCoeff <= 0.0 || contractionCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The contraction coefficient must be in (0, 1).");
+    }
+
+    coefficients.armijoCoeff      = armijoCoeff;
+    coefficients.contractionCoeff = contractionCoeff;
+}
+
+template <int Dim>
+double LineSearchOrthantBackTrack<Dim>::getArmijoCoeff() const
+{
+    return coefficients.armijoCoeff;
+}
+
+template <int Dim>
+double LineSearchOrthantBackTrack<Dim>::getContractionCoeff() const
+{
+    return coefficients.contractionCoeff;
+}
+
+template <int Dim>
+void LineSearchOrthantBackTrack<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    coefficients.maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int LineSearchOrthantBackTrack<Dim>::getMaxNumIterations() const
+{
+    return coefficients.maxNumIterations;
+}
+
+extern template class LineSearchOrthantBackTrack<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,623 @@
+#pragma once
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Optimization/LineSearch.hpp>
+#include <Optimization/ThreadPool.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search policy for StaticSolver evaluating several step lengths at once. It follows
+ *  the bracketing and zoom phases of LineSearchNocedalPolicy, but each phase evaluates a
+ *  grid of candidates concurrently on a thread pool, one candidate per thread:
+ *
+ *      bracketing: stepLength * 2^i,                            i = 0, ..., k - 1
+ *      zoom:       low + (i + 1) / (k + 1) * (high - low),      i = 0, ..., k - 1
+ *
+ *  The candidates are then visited in the order of the serial algorithm and the first one
+ *  satisfying the strong Wolfe conditions is accepted. Once a candidate ends the visit,
+ *  the threads skip the evaluations of all later candidates that have not started yet.
+ *  With a single thread the policy reduces to LineSearchNocedalPolicy.
+ *
+ *  Each candidate is evaluated on its own copy of the objective function, hence the
+ *  callables must be reentrant, see Function. The evaluations of the copies are added to
+ *  the counters of the objective function.
+ */
+
+template <class Objective>
+class LineSearchParallelPolicy
+{
+    public:
+        typedef typename Objective::Vector Vector;
+
+    public:
+        LineSearchParallelPolicy(Objective &                 objFunc,
+                                 std::shared_ptr<ThreadPool> threadPool = nullptr,
+                                 const double                armijoCoeff = 1e-4,
+                                 const double                wolfeCoeff = 0.9,
+                                 const unsigned int          maxNumIterations = 1000);
+
+        bool search(const Vector & lastParameters,
+                    const Vector & lastGradient,
+                    const Vector & direction,
+                    Vector &       parameters,
+                    double &       funcValue,
+                    Vector &       gradient,
+                    double &       stepLength);
+
+        /*
+         *  The thread pool evaluating the candidates. The number of candidates per phase
+         *  equals its number of threads. By default, a pool with one thread per hardware
+         *  thread is created. The copies of the objective function are taken by the next
+         *  search, hence settings of the objective function changed later are seen by the
+         *  candidates only after setting the thread pool again.
+         */
+
+        void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+        std::shared_ptr<ThreadPool> getThreadPool() const;
+
+        /*
+         *  Set the coefficients for the Armijo and Wolfe conditions.
+         *  The armijoCoeff must be in (0, 1). The default value is 1e-4.
+         *  The wolfeCoeff must be in (armijoCoeff, 1). The default value is 0.9.
+         */
+
+        void setCoefficients(double armijoCoeff,
+                             double wolfeCoeff);
+        double getArmijoCoeff() const;
+        double getWolfeCoeff() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+    private:
+        struct Candidate
+        {
+            Objective    objFunc;
+            double       stepLength;
+            Vector       parameters;
+            double       funcValue;
+            Vector       gradient;
+            double       gradDotDir;
+            bool         armijo;
+        };
+
+        enum Phase
+        {
+            Bracketing,
+            Zoom
+        };
+
+        struct Round
+        {
+            Phase                     phase;
+            double                    funcValueLow;
+            double                    intervalLength;
+
+            // Index of the first candidate known to end the visit of the candidates.
+            // Later candidates are not needed anymore.
+            std::atomic<unsigned int> lastIndex;
+        };
+
+        bool bracket(Vector & parameters,
+                     double & funcValue,
+                     Vector & gradient,
+                     double & stepLength);
+
+        bool zoom(double   stepLengthLow,
+                  double   stepLengthHigh,
+                  double   funcValueLow,
+                  Vector & parameters,
+                  double & funcValue,
+                  Vector & gradient,
+                  double & stepLength);
+
+        void evaluate(Phase  phase,
+                      double funcValueLow,
+                      double intervalLength);
+
+        void evalCandidate(unsigned int index,
+                           Round &      round);
+
+        inline void accept(const Candidate & candidate,
+                           Vector &          parameters,
+                           double &          funcValue,
+                           Vector &          gradient,
+                           double &          stepLength) const
+        {
+            parameters = candidate.parameters;
+            funcValue  = candidate.funcValue;
+            gradient   = candidate.gradient;
+            stepLength = candidate.stepLength;
+        }
+
+        inline bool checkArmijo(double stepLength,
+                                double funcValue) const
+        {
+            // Check the Armijo os sufficient decrease condition.
+            return funcValue <= (armijoLineIntercept + stepLength * armijoLineSlope);
+        }
+
+        inline bool checkStrongWolfe(double gradDotDir) const
+        {
+            // Check the Wolfe or curvature condition.
+            return std::fabs(gradDotDir) <= strongWolfeRHS;
+        }
+
+    private:
+        Objective *                 objFunc;
+        std::shared_ptr<ThreadPool> threadPool;
+        unsigned int                maxNumIterations;
+
+        double                      armijoCoeff;
+        double                      wolfeCoeff;
+
+        std::vector<Candidate>      candidates;
+
+        const Vector *              initParameters;
+        const Vector *              direction;
+        double                      armijoLineIntercept;
+        double                      armijoLineSlope;
+        double                      strongWolfeRHS;
+        unsigned int                numIterations;
+};
+
+/*
+ *  Runtime polymorphic adapter of LineSearchParallelPolicy.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class LineSearchParallel : public LineSearch<Dim>
+{
+    public:
+        typedef typename LineSearch<Dim>::Vector Vector;
+
+    public:
+        LineSearchParallel(Function<Dim> &             objFunc,
+                           std::shared_ptr<ThreadPool> threadPool = nullptr,
+                           const double                armijoCoeff = 1e-4,
+                           const double                wolfeCoeff = 0.9,
+                           const unsigned int          maxNumIterations = 1000);
+
+        ~LineSearchParallel();
+
+        inline bool search(const Vector & lastParameters,
+                           const Vector & lastGradient,
+                           const Vector & direction,
+                           Vector &       parameters,
+                           double &       funcValue,
+                           Vector &       gradient,
+                           double &       stepLength) override
+        {
+            policy.setMaxNumIterations(this->maxNumIterations);
+
+            return policy.search(lastParameters, lastGradient, direction, parameters, funcValue, gradient, stepLength);
+        }
+
+        inline void setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+        {
+            policy.setThreadPool(threadPool);
+        }
+
+        inline std::shared_ptr<ThreadPool> getThreadPool() const
+        {
+            return policy.getThreadPool();
+        }
+
+        inline void setCoefficients(double armijoCoeff,
+                                    double wolfeCoeff)
+        {
+            policy.setCoefficients(armijoCoeff, wolfeCoeff);
+        }
+
+        inline double getArmijoCoeff() const
+        {
+            return policy.getArmijoCoeff();
+        }
+
+        inline double getWolfeCoeff() const
+        {
+            return policy.getWolfeCoeff();
+        }
+
+    private:
+        LineSearchParallelPolicy<Function<Dim>> policy;
+};
+
+template <class Objective>
+LineSearchParallelPolicy<Objective>::LineSearchParallelPolicy(Objective &                 objFunc,
+                                                              std::shared_ptr<ThreadPool> threadPool,
+                                                              const double                armijoCoeff,
+                                                              const double                wolfeCoeff,
+                                                              const unsigned int          maxNumIterations)
+{
+    this->objFunc = &objFunc;
+    setThreadPool(threadPool);
+    setMaxNumIterations(maxNumIterations);
+    setCoefficients(armijoCoeff, wolfeCoeff);
+}
+
+template <class Objective>
+bool LineSearchParallelPolicy<Objective>::search(const Vector & initParameters,
+                                                 const Vector & initGradient,
+                                                 const Vector & direction,
+                                                 Vector &       parameters,
+                                                 double &       funcValue,
+                                                 Vector &       gradient,
+                                                 double &       stepLength)
+{
+    // Step length has to be positive.
+    if (stepLength <= 0)
+    {
+        throw std::invalid_argument("Initial step length must be greater than zero.");
+    }
+
+    const double initGradDotDir = initGradient.dot(direction);
+
+    // Ensure that the initial direction is a descent direction.
+    if (0 < initGradDotDir)
+    {
+        throw std::invalid_argument("Direction is not a descent direction.");
+    }
+
+    this->initParameters      = &initParameters;
+    this->direction           = &direction;
+    this->armijoLineIntercept = funcValue;
+    this->armijoLineSlope     = armijoCoeff * initGradDotDir;
+    this->strongWolfeRHS      = -wolfeCoeff * initGradDotDir;
+    this->numIterations       = 0;
+
+    // Give every candidate its own copy of the objective function, so that the threads
+    // neither share its buffers nor its counters. The candidates are built by the first
+    // search for a thread pool and number of parameters, and reused by later searches.
+    const unsigned int numCandidates = threadPool->getNumThreads();
+    if (candidates.size() != numCandidates || candidates.front().parameters.size() != initParameters.size())
+    {
+        candidates.clear();
+        candidates.reserve(numCandidates);
+        for (unsigned int i = 0; i < numCandidates; ++i)
+        {
+            candidates.push_back(Candidate{*objFunc, 0.0, initParameters, 0.0, initGradient, 0.0, false});
+        }
+    }
+
+    for (Candidate & candidate : candidates)
+    {
+        candidate.objFunc.resetNumEvaluations();
+    }
+
+    const bool stepLengthFound = bracket(parameters, funcValue, gradient, stepLength);
+
+    for (Candidate & candidate : candidates)
+    {
+        objFunc->addNumEvaluations(candidate.objFunc.getNumFuncEvaluations(),
+                                   candidate.objFunc.getNumGradEvaluations());
+    }
+
+    return stepLengthFound;
+}
+
+/*
+ *  Implements the bracketing phase of line search Algorithm 3.5 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 60
+ */
+
+template <class Objective>
+bool LineSearchParallelPolicy<Objective>::bracket(Vector & parameters,
+                                                  double & funcValue,
+                                                  Vector & gradient,
+                                                  double & stepLength)
+{
+    double lastStepLength = 0.0;
+    double lastFuncValue  = armijoLineIntercept;
+
+    while (true)
+    {
+        // Extrapolate step length in exponential fashion.
+        for (Candidate & candidate : candidates)
+        {
+            candidate.stepLength = stepLength;
+            stepLength = 2.0 * stepLength;
+        }
+
+        evaluate(Bracketing, lastFuncValue, 0.0);
+
+        for (const Candidate & candidate : candidates)
+        {
+            if (!candidate.armijo || candidate.funcValue >= lastFuncValue)
+            {
+                return zoom(lastStepLength, candidate.stepLength, lastFuncValue, parameters, funcValue, gradient, stepLength);
+            }
+
+            if (checkStrongWolfe(candidate.gradDotDir))
+            {
+                // Line search was successful.
+                accept(candidate, parameters, funcValue, gradient, stepLength);
+                return true;
+            }
+
+            if (candidate.gradDotDir >= 0.0)
+            {
+                return zoom(candidate.stepLength, lastStepLength, candidate.funcValue, parameters, funcValue, gradient, stepLength);
+            }
+
+            lastStepLength = candidate.stepLength;
+            lastFuncValue  = candidate.funcValue;
+        }
+
+        if (std::isinf(stepLength))
+        {
+            // Reached maximum possible step length.
+            return false;
+        }
+    }
+}
+
+/*
+ *  Implements line search zoom Algorithm 3.6 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 61
+ *  where the bisection is replaced by a grid inside the bracketed interval.
+ */
+
+template <class Objective>
+bool LineSearchParallelPolicy<Objective>::zoom(double   stepLengthLow,
+                                               double   stepLengthHigh,
+                                               double   funcValueLow,
+                                               Vector & parameters,
+                                               double & funcValue,
+                                               Vector & gradient,
+                                               double & stepLength)
+{
+    const double numIntervals = candidates.size() + 1.0;
+
+    while (true)
+    {
+        ++numIterations;
+
+        // Length of the bracketed interval is too small. More specifically, it is smaller
+        // than the increment used in forward difference.
+        const double intervalLength = stepLengthHigh - stepLengthLow;
+        if (std::fabs(intervalLength) < DBL_EPSILON)
+        {
+            return false;
+        }
+
+        // Divide current step length interval, ordered from the lower bound.
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            candidates[i].stepLength = stepLengthLow + (i + 1) / numIntervals * intervalLength;
+        }
+
+        evaluate(Zoom, funcValueLow, intervalLength);
+
+        // Visit the candidates as the serial algorithm would. Once the bracket shrinks,
+        // the remaining candidates lie outside of it.
+        for (const Candidate & candidate : candidates)
+        {
+            if (!candidate.armijo || candidate.funcValue >= funcValueLow)
+            {
+                // Change upper bound.
+                stepLengthHigh = candidate.stepLength;
+                break;
+            }
+
+            if (checkStrongWolfe(candidate.gradDotDir))
+            {
+                // Line search was successful.
+                accept(candidate, parameters, funcValue, gradient, stepLength);
+                return true;
+            }
+
+            const bool changeHigh = (candidate.gradDotDir * intervalLength >= 0);
+            if (changeHigh)
+            {
+                // Change upper bound.
+                stepLengthHigh = stepLengthLow;
+            }
+            // Change lower bound.
+            stepLengthLow = candidate.stepLength;
+            funcValueLow  = candidate.funcValue;
+
+            if (changeHigh)
+            {
+                break;
+            }
+        }
+
+        if (numIterations > maxNumIterations)
+        {
+            // Reached maximum number of allowed iteration.
+            return false;
+        }
+    }
+}
+
+template <class Objective>
+void LineSearchParallelPolicy<Objective>::evaluate(Phase  phase,
+                                                   double funcValueLow,
+                                                   double intervalLength)
+{
+    const unsigned int numCandidates = static_cast<unsigned int>(candidates.size());
+
+    Round round{phase, funcValueLow, intervalLength, {numCandidates}};
+
+    threadPool->run(numCandidates,
+                    [this, &round](unsigned int index)
+                    {
+                        evalCandidate(index, round);
+                    });
+}
+
+template <class Objective>
+void LineSearchParallelPolicy<Objective>::evalCandidate(unsigned int index,
+                                                        Round &      round)
+{
+    Candidate & candidate = candidates[index];
+
+    // An unneeded candidate is marked as failing the Armijo condition, which the visit
+    // never reaches.
+    candidate.armijo = false;
+    if (index > round.lastIndex.load())
+    {
+        return;
+    }
+
+    candidate.parameters = (*initParameters) + candidate.stepLength * (*direction);
+    candidate.objFunc.calcObjFuncValue(candidate.parameters, candidate.funcValue);
+
+    bool lastNeeded;
+    if (!checkArmijo(candidate.stepLength, candidate.funcValue))
+    {
+        lastNeeded = true;
+    }
+    else if (round.phase == Zoom && candidate.funcValue >= round.funcValueLow)
+    {
+        candidate.armijo = true;
+        lastNeeded = true;
+    }
+    else
+    {
+        candidate.armijo = true;
+        if (index > round.lastIndex.load())
+        {
+            return;
+        }
+
+        // Without an exact gradient, the directional derivative is approximated first and
+        // the full gradient is only computed when the candidate may be accepted.
+        bool fullGrad = candidate.objFunc.hasGradient();
+        if (!fullGrad)
+        {
+            candidate.gradDotDir = candidate.objFunc.calcDirectionalDerivative(candidate.parameters,
+                                                                                candidate.funcValue,
+                                                                                *direction);
+            fullGrad = checkStrongWolfe(candidate.gradDotDir);
+        }
+
+        if (fullGrad)
+        {
+            candidate.objFunc.calcGrad(candidate.parameters, candidate.gradient);
+            candidate.gradDotDir = candidate.gradient.dot(*direction);
+        }
+
+        lastNeeded = checkStrongWolfe(candidate.gradDotDir) ||
+                     (round.phase == Bracketing ? candidate.gradDotDir >= 0.0
+                                                : candidate.gradDotDir * round.intervalLength >= 0);
+    }
+
+    if (lastNeeded)
+    {
+        unsigned int current = round.lastIndex.load();
+        while (index < current && !round.lastIndex.compare_exchange_weak(current, index))
+        {
+        }
+    }
+}
+
+template <class Objective>
+void LineSearchParallelPolicy<Objective>::setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+{
+    if (threadPool == nullptr)
+    {
+        this->threadPool = std::make_shared<ThreadPool>();
+    }
+    else
+    {
+        this->threadPool = threadPool;
+    }
+
+    // The candidates are rebuilt by the next search.
+    candidates.clear();
+}
+
+template <class Objective>
+std::shared_ptr<ThreadPool> LineSearchParallelPolicy<Objective>::getThreadPool() const
+{
+    return threadPool;
+}
+
+template <class Objective>
+void LineSearchParallelPolicy<Objective>::setCoefficients(double armijoCoeff,
+                                                          double wolfeCoeff)
+{
+    if (armijoCoeff <= 0.0 || armijoCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Armijo coefficient must be in (0, 1).");
+    }
+
+    if (wolfeCoeff <= armijoCoeff || wolfeCoeff >= 1.0)
+    {
+        throw std::invalid_argument("The Wolfe coefficient must be in (armijoCoeff, 1).");
+    }
+
+    this->armijoCoeff = armijoCoeff;
+    this->wolfeCoeff  = wolfeCoeff;
+}
+
+template <class Objective>
+double LineSearchParallelPolicy<Objective>::getArmijoCoeff() const
+{
+    return armijoCoeff;
+}
+
+template <class Objective>
+double LineSearchParallelPolicy<Objective>::getWolfeCoeff() const
+{
+    return wolfeCoeff;
+}
+
+template <class Objective>
+void LineSearchParallelPolicy<Objective>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of iterations must be greater than zero.");
+    }
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective>
+unsigned int LineSearchParallelPolicy<Objective>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+LineSearchParallel<Dim>::LineSearchParallel(Function<Dim> &             objFunc,
+                                            std::shared_ptr<ThreadPool> threadPool,
+                                            const double                armijoCoeff,
+                                            const double                wolfeCoeff,
+                                            const unsigned int          maxNumIterations)
+                                            :
+                                            LineSearch<Dim>(objFunc,
+                                                            maxNumIterations),
+                                            policy(objFunc,
+                                                   threadPool,
+                                                   armijoCoeff,
+                                                   wolfeCoeff,
+                                                   maxNumIterations)
+{
+
+}
+
+template <int Dim>
+LineSearchParallel<Dim>::~LineSearchParallel()
+{
+
+}
+
+extern template class LineSearchParallelPolicy<Function<Eigen::Dynamic>>;
+extern template class LineSearchParallel<Eigen::Dynamic>;
+
+}
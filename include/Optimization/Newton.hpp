@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Cholesky>
+#include <Optimization/BaseAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Direction policy for StaticSolver. The Hessian is taken from the objective function, see
+ *  BasicFunction::calcHessian, hence the policy is constructed with it, e.g.
+ *
+ *      StaticSolver<Objective, NewtonPolicy<Objective>, LineSearchNocedalPolicy<Objective>> solver(
+ *          objFunc, initialParameters, NewtonPolicy<Objective>(objFunc), LineSearchNocedalPolicy<Objective>(objFunc));
+ */
+
+template <class Objective>
+class NewtonPolicy
+{
+    public:
+        typedef typename Objective::Vector Vector;
+        typedef typename Objective::Matrix Matrix;
+
+    public:
+        NewtonPolicy(Objective & objFunc,
+                     double      shiftCoeff = 1e-3);
+
+        void initialDirection(const Vector & parameters,
+                              const Vector & gradient,
+                              Vector &       direction);
+
+        void updateDirection(const Vector & parameters,
+                             const Vector & gradient,
+                             const Vector & lastParameters,
+                             const Vector & lastGradient,
+                             Vector &       direction);
+
+        /*
+         *  The smallest multiple of the identity added to an indefinite Hessian, relative to
+         *  the largest magnitude of its diagonal. The default value is 1e-3.
+         */
+
+        void setShiftCoeff(double shiftCoeff);
+        double getShiftCoeff() const;
+
+        /*
+         *  The multiple of the identity added to the last Hessian, zero if it was positive
+         *  definite.
+         */
+
+        inline double getLastShift() const
+        {
+            return shift;
+        }
+
+    private:
+        void calcDirection(const Vector & parameters,
+                           const Vector & gradient,
+                           Vector &       direction);
+
+    private:
+        Objective *       objFunc;
+        double            shiftCoeff;
+        double            shift;
+
+        Matrix            hessian;
+        Matrix            shiftedHessian;
+        Eigen::LLT<Matrix> cholesky;
+};
+
+/*
+ *  Newton's method with line search. Far from a minimizer the Hessian may be indefinite, then
+ *  a multiple of the identity is added to make it positive definite, hence the direction is a
+ *  descent direction. Close to a minimizer with a positive definite Hessian the unit step is
+ *  accepted and the method converges quadratically. The unit step length is therefore tried
+ *  first, see InitialStepUnit. A Hessian with non-finite entries throws std::invalid_argument.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class Newton : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector Vector;
+
+    public:
+        Newton(Function<Dim> &               objFunc,
+               const Vector &                initialParameters,
+               double                        gradTol = 1e-9,
+               double                        relTol = 1e-9,
+               unsigned int                  maxNumIterations = 100000,
+               typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        ~Newton();
+
+        inline void setShiftCoeff(double shiftCoeff)
+        {
+            policy.setShiftCoeff(shiftCoeff);
+        }
+
+        inline double getShiftCoeff() const
+        {
+            return policy.getShiftCoeff();
+        }
+
+    private:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
+    private:
+        NewtonPolicy<Function<Dim>> policy;
+};
+
+template <class Objective>
+NewtonPolicy<Objective>::NewtonPolicy(Objective & objFunc,
+                                      double      shiftCoeff)
+                                      :
+                                      objFunc(&objFunc),
+                                      shift(0.0)
+{
+    setShiftCoeff(shiftCoeff);
+}
+
+template <class Objective>
+void NewtonPolicy<Objective>::initialDirection(const Vector & parameters,
+                                               const Vector & gradient,
+                                               Vector &       direction)
+{
+    calcDirection(parameters, gradient, direction);
+}
+
+template <class Objective>
+void NewtonPolicy<Objective>::updateDirection(const Vector & parameters,
+                                              const Vector & gradient,
+                                              const Vector & lastParameters,
+                                              const Vector & lastGradient,
+                                              Vector &       direction)
+{
+    calcDirection(parameters, gradient, direction);
+}
+
+/*
+ *  Implements the Cholesky with added multiple of the identity Algorithm 3.3 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 51
+ */
+
+template <class Objective>
+void NewtonPolicy<Objective>::calcDirection(const Vector & parameters,
+                                            const Vector & gradient,
+                                            Vector &       direction)
+{
+    objFunc->calcHessian(parameters, hessian);
+
+    // No shift makes a Hessian with non-finite entries positive definite.
+    if (!hessian.allFinite())
+    {
+        throw std::invalid_argument("The Hessian is not finite.");
+    }
+
+    shift = 0.0;
+    cholesky.compute(hessian);
+
+    if (cholesky.info() != Eigen::Success)
+    {
+        // The shifts are relative to the scale of the Hessian.
+        const double beta = shiftCoeff * std::max(1.0, hessian.diagonal().cwiseAbs().maxCoeff());
+        const double minDiagonal = hessian.diagonal().minCoeff();
+
+        shift = (minDiagonal > 0.0) ? beta : beta - minDiagonal;
+
+        while (true)
+        {
+            shiftedHessian = hessian;
+            shiftedHessian.diagonal().array() += shift;
+
+            cholesky.compute(shiftedHessian);
+            if (cholesky.info() == Eigen::Success)
+            {
+                break;
+            }
+
+            shift = std::max(2 * shift, beta);
+            if (std::isinf(shift))
+            {
+                throw std::invalid_argument("The Hessian cannot be shifted to be positive definite.");
+            }
+        }
+    }
+
+    direction = -gradient;
+    cholesky.solveInPlace(direction);
+}
+
+template <class Objective>
+void NewtonPolicy<Objective>::setShiftCoeff(double shiftCoeff)
+{
+    if (shiftCoeff <= 0.0)
+    {
+        throw std::invalid_argument("The shift coefficient must be greater than zero.");
+    }
+
+    this->shiftCoeff = shiftCoeff;
+}
+
+template <class Objective>
+double NewtonPolicy<Objective>::getShiftCoeff() const
+{
+    return shiftCoeff;
+}
+
+template <int Dim>
+Newton<Dim>::Newton(Function<Dim> &               objFunc,
+                    const Vector &                initialParameters,
+                    double                        gradTol,
+                    double                        relTol,
+                    unsigned int                  maxNumIterations,
+                    typename LineSearch<Dim>::Ptr lineSearch)
+                    :
+                    BaseAlgorithm<Dim>(objFunc,
+                                       initialParameters,
+                                       gradTol,
+                                       relTol,
+                                       maxNumIterations,
+                                       lineSearch),
+                    policy(objFunc)
+{
+    this->setInitialStep(std::make_shared<InitialStepUnit<Dim>>());
+}
+
+template <int Dim>
+Newton<Dim>::~Newton()
+{
+
+}
+
+extern template class NewtonPolicy<Function<Eigen::Dynamic>>;
+extern template class Newton<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Optimization/CompactLBFGS.hpp>
+#include <Optimization/Function.hpp>
+#include <Optimization/LineSearchOrthantBackTrack.hpp>
+#include <Optimization/Result.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Orthant-wise limited-memory quasi-Newton method for L1-regularized problems
+ *
+ *      F(x) = f(x) + l1Weight ||x||_1
+ *
+ *  with a smooth f. The gradient of f is replaced by the pseudo-gradient of F, i.e. the
+ *  one-sided derivative of steepest descent, and the limited-memory BFGS direction built from
+ *  the gradients of f is restricted to the orthant of the current parameters. The line search
+ *  projects every trial point back onto that orthant, see LineSearchOrthantBackTrack, so
+ *  parameters reach zero exactly and the iterates stay sparse. The secant pairs are kept by
+ *  CompactLBFGS, hence time and memory per iteration are O(mn) on flat n x m panels.
+ *
+ *  The gradient tolerance applies to the infinity norm of the pseudo-gradient, which is also
+ *  reported as the gradient norm of the result, and the reported function value is F.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class OWLQN
+{
+    public:
+        typedef typename Function<Dim>::Vector Vector;
+
+    public:
+        OWLQN(Function<Dim> & objFunc,
+              double          l1Weight,
+              const Vector &  initialParameters,
+              double          gradTol = 1e-9,
+              double          relTol = 1e-9,
+              unsigned int    maxNumIterations = 100000);
+
+        ~OWLQN();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        void setL1Weight(double l1Weight);
+        double getL1Weight() const;
+
+        unsigned int getNumIterations() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  The number of stored secant pairs. The default value is 5.
+         */
+
+        inline void setMemory(unsigned int memory)
+        {
+            matrix.setMemory(memory);
+        }
+
+        inline unsigned int getMemory() const
+        {
+            return matrix.getMemory();
+        }
+
+        inline LineSearchOrthantBackTrack<Dim> & getLineSearch()
+        {
+            return lineSearch;
+        }
+
+    private:
+        void computePseudoGradient();
+
+        void computeDirection();
+
+    private:
+        Vector                          initialParameters;
+        double                          l1Weight;
+
+        double                          gradTol;
+        double                          relTol;
+        unsigned int                    numIterations;
+        unsigned int                    maxNumIterations;
+
+        Vector                          parameters;
+        Vector                          gradient;
+        Vector                          pseudoGradient;
+        Vector                          direction;
+        Vector                          orthant;
+        Vector                          lastParameters;
+        Vector                          lastGradient;
+
+        CompactLBFGS<Dim>               matrix;
+        LineSearchOrthantBackTrack<Dim> lineSearch;
+
+        Function<Dim> *                 objFunc;
+};
+
+template <int Dim>
+OWLQN<Dim>::OWLQN(Function<Dim> & objFunc,
+                  double          l1Weight,
+                  const Vector &  initialParameters,
+                  double          gradTol,
+                  double          relTol,
+                  unsigned int    maxNumIterations)
+                  :
+                  lineSearch(objFunc)
+{
+    setInitialParameters(initialParameters);
+    setL1Weight(l1Weight);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    setMaxNumIterations(maxNumIterations);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+OWLQN<Dim>::~OWLQN()
+{
+
+}
+
+/*
+ *  Pseudo-gradient of F, zero where no one-sided derivative is negative, and the orthant the
+ *  next iterate stays in: the sign of the parameter, or of the negative pseudo-gradient for
+ *  parameters at zero.
+ */
+
+template <int Dim>
+void OWLQN<Dim>::computePseudoGradient()
+{
+    const Eigen::Index numParameters = parameters.size();
+
+    for (Eigen::Index i = 0; i < numParameters; ++i)
+    {
+        const double x = parameters(i);
+        const double g = gradient(i);
+
+        if (x > 0.0)
+        {
+            pseudoGradient(i) = g + l1Weight;
+            orthant(i) = 1.0;
+        }
+        else if (x < 0.0)
+        {
+            pseudoGradient(i) = g - l1Weight;
+            orthant(i) = -1.0;
+        }
+        else if (g + l1Weight < 0.0)
+        {
+            pseudoGradient(i) = g + l1Weight;
+            orthant(i) = 1.0;
+        }
+        else if (g - l1Weight > 0.0)
+        {
+            pseudoGradient(i) = g - l1Weight;
+            orthant(i) = -1.0;
+        }
+        else
+        {
+            pseudoGradient(i) = 0.0;
+            orthant(i) = 0.0;
+        }
+    }
+}
+
+/*
+ *  Limited-memory direction -H pseudoGradient with the components removed whose sign
+ *  disagrees with the negative pseudo-gradient. Falls back to the negative pseudo-gradient if
+ *  nothing of a descent direction is left.
+ */
+
+template <int Dim>
+void OWLQN<Dim>::computeDirection()
+{
+    matrix.applyInverseHessian(pseudoGradient, direction);
+    direction = (direction.array() * pseudoGradient.array() > 0.0).select(-direction, 0.0);
+
+    if (pseudoGradient.dot(direction) >= 0.0)
+    {
+        direction = -pseudoGradient;
+    }
+}
+
+/*
+ *  Implements the OWL-QN algorithm of
+ *  Galen Andrew and Jianfeng Gao, Scalable Training of L1-Regularized Log-Linear Models,
+ *  Proceedings of the 24th International Conference on Machine Learning, 2007
+ */
+
+template <int Dim>
+void OWLQN<Dim>::solve(Result & result)
+{
+    const Eigen::Index numParameters = initialParameters.size();
+
+    double funcValue;
+    double totalFuncValue;
+    double lastTotalFuncValue;
+
+    parameters = initialParameters;
+    gradient.resize(numParameters);
+    pseudoGradient.resize(numParameters);
+    orthant.resize(numParameters);
+    lastGradient.resize(numParameters);
+
+    matrix.reset(numParameters);
+
+    numIterations = 0;
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Evaluate the function and its gradient.
+    objFunc->calcObjFuncValue(parameters, funcValue);
+    objFunc->calcGrad(parameters, gradient);
+    totalFuncValue = funcValue + l1Weight * parameters.template lpNorm<1>();
+
+    computePseudoGradient();
+
+    // Ensure that the initial parameters are not a minimizer.
+    double pseudoGradNorm = pseudoGradient.template lpNorm<Eigen::Infinity>();
+    if (pseudoGradNorm <= gradTol)
+    {
+        result.set(Gradient, parameters, totalFuncValue, pseudoGradNorm, numIterations,
+                   objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+        return;
+    }
+
+    while (true)
+    {
+        ++numIterations;
+
+        computeDirection();
+
+        lastParameters.swap(parameters);
+        lastGradient.swap(gradient);
+        lastTotalFuncValue = totalFuncValue;
+
+        // Without stored pairs the direction is not scaled, so the first step has unit length.
+        double stepLength = (matrix.getNumPairs() == 0) ? 1.0 / direction.norm() : 1.0;
+
+        bool success = lineSearch.search(lastParameters, lastTotalFuncValue, pseudoGradient, direction, orthant, l1Weight,
+                                         parameters, funcValue, totalFuncValue, gradient, stepLength);
+
+        // Retry once along the negative pseudo-gradient without the stored pairs.
+        if (!success && matrix.getNumPairs() > 0)
+        {
+            matrix.reset(numParameters);
+            direction = -pseudoGradient;
+            stepLength = 1.0 / direction.norm();
+
+            success = lineSearch.search(lastParameters, lastTotalFuncValue, pseudoGradient, direction, orthant, l1Weight,
+                                        parameters, funcValue, totalFuncValue, gradient, stepLength);
+        }
+
+        if (!success)
+        {
+            result.set(LineSearchFailed, lastParameters, lastTotalFuncValue, pseudoGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // The secant pair is formed from the gradients of the smooth part. Both vectors are
+        // recomputed by the next line search, hence they hold s and y in the meantime.
+        lastParameters = parameters - lastParameters;
+        lastGradient = gradient - lastGradient;
+        matrix.update(lastParameters, lastGradient);
+
+        computePseudoGradient();
+
+        // Gradient convergence test.
+        pseudoGradNorm = pseudoGradient.template lpNorm<Eigen::Infinity>();
+        if (pseudoGradNorm <= gradTol)
+        {
+            result.set(Gradient, parameters, totalFuncValue, pseudoGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Relative convergence test.
+        if (std::fabs(lastTotalFuncValue - totalFuncValue) <= relTol * std::fabs(totalFuncValue))
+        {
+            result.set(Relative, parameters, totalFuncValue, pseudoGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, parameters, totalFuncValue, pseudoGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void OWLQN<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename OWLQN<Dim>::Vector & OWLQN<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+void OWLQN<Dim>::setL1Weight(double l1Weight)
+{
+    if (l1Weight < 0.0)
+    {
+        throw std::invalid_argument("The weight of the L1 norm must be greater than or equal to zero.");
+    }
+    this->l1Weight = l1Weight;
+}
+
+template <int Dim>
+double OWLQN<Dim>::getL1Weight() const
+{
+    return l1Weight;
+}
+
+template <int Dim>
+unsigned int OWLQN<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+void OWLQN<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int OWLQN<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+void OWLQN<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double OWLQN<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void OWLQN<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double OWLQN<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+extern template class OWLQN<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Optimization/Function.hpp>
+
+
+namespace Optimization
+{
+
+template <int Dim>
+class QuadraticFunction;
+
+/*
+ *  Restriction of a quadratic function to a line,
+ *
+ *      phi(stepLength) = f + stepLength * g^T d + 0.5 * stepLength^2 * d^T A d,
+ *
+ *  where f and g are the function value and the gradient at the origin of the line. After
+ *  the product A d is computed once in setLine, phi, its derivative and the gradient on the
+ *  line need no further products with A.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class QuadraticLineRestriction
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        QuadraticLineRestriction(QuadraticFunction<Dim> & objFunc);
+
+        void setLine(const Vector & initParameters,
+                     double         initFuncValue,
+                     const Vector & initGradient,
+                     const Vector & direction);
+
+        inline double calcValue(double stepLength) const
+        {
+            return initFuncValue + stepLength * (initGradDotDir + 0.5 * stepLength * curvature);
+        }
+
+        inline double calcDerivative(double stepLength,
+                                     double funcValue,
+                                     bool   approximate = false) const
+        {
+            return initGradDotDir + stepLength * curvature;
+        }
+
+        void calcGrad(double   stepLength,
+                      Vector & parameters,
+                      Vector & gradient) const;
+
+        /*
+         *  Computes the function value at parameters from the gradient there,
+         *
+         *      f = 0.5 * x^T (g - b) + c,
+         *
+         *  without a product with A. Unlike phi, whose origin is the function value at the
+         *  end of the previous line, it does not accumulate the rounding errors of the lines.
+         */
+
+        double calcFuncValue(const Vector & parameters,
+                             const Vector & gradient) const;
+
+        /*
+         *  Computes the minimizer of phi. Returns false if phi is not strictly convex, i.e.
+         *  the quadratic function is unbounded below along the line.
+         */
+
+        bool calcMinimizer(double & stepLength) const;
+
+    private:
+        QuadraticFunction<Dim> * objFunc;
+
+        const Vector *           initParameters;
+        const Vector *           initGradient;
+        const Vector *           direction;
+        double                   initFuncValue;
+        double                   initGradDotDir;
+        double                   curvature;
+
+        Vector                   hessianDirection;
+};
+
+/*
+ *  The quadratic function
+ *
+ *      f(x) = 0.5 * x^T A x - b^T x + c
+ *
+ *  with a symmetric matrix A, given either dense or sparse. It is a Function, hence every
+ *  solver accepts it. In addition, the solvers detect it and use the exact line search of
+ *  LineSearchExact.hpp by default, and with ConjugateGradient they reduce to the linear
+ *  conjugate gradient method, which converges in at most n iterations for a positive
+ *  definite A. Its Hessian callable returns A, hence Newton takes a single iteration.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class QuadraticFunction : public Function<Dim>
+{
+    public:
+        typedef typename Function<Dim>::Vector  Vector;
+        typedef Eigen::Matrix<double, Dim, Dim> Matrix;
+        typedef Eigen::SparseMatrix<double>     SparseMatrix;
+
+        typedef QuadraticLineRestriction<Dim>   LineRestriction;
+
+    public:
+        QuadraticFunction(const Matrix & matrix,
+                          const Vector & linearTerm,
+                          double         constant = 0.0);
+
+        QuadraticFunction(const SparseMatrix & matrix,
+                          const Vector &       linearTerm,
+                          double               constant = 0.0);
+
+        // The callables of the base class refer to this object.
+        QuadraticFunction(const QuadraticFunction &) = delete;
+        QuadraticFunction & operator=(const QuadraticFunction &) = delete;
+
+        ~QuadraticFunction();
+
+        /*
+         *  Computes product = A * vector. It is counted as a gradient evaluation, which
+         *  costs the same.
+         */
+
+        void calcMatrixProduct(const Vector & vector,
+                               Vector &       product);
+
+        inline bool isSparse() const
+        {
+            return sparse;
+        }
+
+        inline const Vector & getLinearTerm() const
+        {
+            return linearTerm;
+        }
+
+        inline double getConstant() const
+        {
+            return constant;
+        }
+
+    private:
+        void multiply(const Vector & vector,
+                      Vector &       product) const;
+
+        double quadraticForm(const Vector & vector) const;
+
+    private:
+        bool         sparse;
+        Matrix       denseMatrix;
+        SparseMatrix sparseMatrix;
+        Vector       linearTerm;
+        double       constant;
+};
+
+template <int Dim>
+QuadraticLineRestriction<Dim>::QuadraticLineRestriction(QuadraticFunction<Dim> & objFunc)
+:
+objFunc(&objFunc),
+initParameters(nullptr),
+initGradient(nullptr),
+direction(nullptr),
+initFuncValue(0.0),
+initGradDotDir(0.0),
+curvature(0.0)
+{
+
+}
+
+template <int Dim>
+void QuadraticLineRestriction<Dim>::setLine(const Vector & initParameters,
+                                            double         initFuncValue,
+                                            const Vector & initGradient,
+                                            const Vector & direction)
+{
+    this->initParameters = &initParameters;
+    this->initGradient   = &initGradient;
+    this->direction      = &direction;
+    this->initFuncValue  = initFuncValue;
+
+    objFunc->calcMatrixProduct(direction, hessianDirection);
+
+    initGradDotDir = initGradient.dot(direction);
+    curvature      = direction.dot(hessianDirection);
+}
+
+template <int Dim>
+void QuadraticLineRestriction<Dim>::calcGrad(double   stepLength,
+                                             Vector & parameters,
+                                             Vector & gradient) const
+{
+    parameters = (*initParameters) + stepLength * (*direction);
+    gradient   = (*initGradient) + stepLength * hessianDirection;
+}
+
+template <int Dim>
+double QuadraticLineRestriction<Dim>::calcFuncValue(const Vector & parameters,
+                                                    const Vector & gradient) const
+{
+    return 0.5 * parameters.dot(gradient - objFunc->getLinearTerm()) + objFunc->getConstant();
+}
+
+template <int Dim>
+bool QuadraticLineRestriction<Dim>::calcMinimizer(double & stepLength) const
+{
+    if (curvature <= 0.0)
+    {
+        return false;
+    }
+
+    stepLength = -initGradDotDir / curvature;
+
+    return true;
+}
+
+template <int Dim>
+QuadraticFunction<Dim>::QuadraticFunction(const Matrix & matrix,
+                                          const Vector & linearTerm,
+                                          double         constant)
+                                          :
+                                          Function<Dim>([this](const Vector & parameters, double & funcValue)
+                                                        {
+                                                            funcValue = 0.5 * quadraticForm(parameters) - parameters.dot(this->linearTerm) + this->constant;
+                                                        },
+                                                        [this](const Vector & parameters, Vector & gradient)
+                                                        {
+                                                            multiply(parameters, gradient);
+                                                            gradient -= this->linearTerm;
+                                                        },
+                                                        nullptr,
+                                                        [this](const Vector & parameters, Matrix & hessian)
+                                                        {
+                                                            if (sparse)
+                                                            {
+                                                                hessian = sparseMatrix;
+                                                            }
+                                                            else
+                                                            {
+                                                                hessian = denseMatrix;
+                                                            }
+                                                        }),
+                                          sparse(false),
+                                          denseMatrix(matrix),
+                                          linearTerm(linearTerm),
+                                          constant(constant)
+{
+    if (matrix.rows() != matrix.cols() || matrix.rows() != linearTerm.size())
+    {
+        throw std::invalid_argument("The matrix must be square and match the size of the linear term.");
+    }
+}
+
+template <int Dim>
+QuadraticFunction<Dim>::QuadraticFunction(const SparseMatrix & matrix,
+                                          const Vector &       linearTerm,
+                                          double               constant)
+                                          :
+                                          Function<Dim>([this](const Vector & parameters, double & funcValue)
+                                                        {
+                                                            funcValue = 0.5 * quadraticForm(parameters) - parameters.dot(this->linearTerm) + this->constant;
+                                                        },
+                                                        [this](const Vector & parameters, Vector & gradient)
+                                                        {
+                                                            multiply(parameters, gradient);
+                                                            gradient -= this->linearTerm;
+                                                        },
+                                                        nullptr,
+                                                        [this](const Vector & parameters, Matrix & hessian)
+                                                        {
+                                                            if (sparse)
+                                                            {
+                                                                hessian = sparseMatrix;
+                                                            }
+                                                            else
+                                                            {
+                                                                hessian = denseMatrix;
+                                                            }
+                                                        }),
+                                          sparse(true),
+                                          sparseMatrix(matrix),
+                                          linearTerm(linearTerm),
+                                          constant(constant)
+{
+    if (matrix.rows() != matrix.cols() || matrix.rows() != linearTerm.size())
+    {
+        throw std::invalid_argument("The matrix must be square and match the size of the linear term.");
+    }
+}
+
+template <int Dim>
+QuadraticFunction<Dim>::~QuadraticFunction()
+{
+
+}
+
+template <int Dim>
+void QuadraticFunction<Dim>::calcMatrixProduct(const Vector & vector,
+                                               Vector &       product)
+{
+    this->addNumEvaluations(0, 1);
+    multiply(vector, product);
+}
+
+template <int Dim>
+void QuadraticFunction<Dim>::multiply(const Vector & vector,
+                                      Vector &       product) const
+{
+    if (sparse)
+    {
+        product.noalias() = sparseMatrix * vector;
+    }
+    else
+    {
+        product.noalias() = denseMatrix * vector;
+    }
+}
+
+/*
+ *  Computes vector^T A vector column by column, without a temporary for A * vector. The
+ *  value callable only reads the members, hence copies of the function, e.g. those of
+ *  LineSearchParallel, can evaluate it concurrently.
+ */
+
+template <int Dim>
+double QuadraticFunction<Dim>::quadraticForm(const Vector & vector) const
+{
+    double value = 0.0;
+
+    if (sparse)
+    {
+        for (Eigen::Index k = 0; k < sparseMatrix.outerSize(); ++k)
+        {
+            double columnDot = 0.0;
+            for (typename SparseMatrix::InnerIterator it(sparseMatrix, k); it; ++it)
+            {
+                columnDot += it.value() * vector(it.row());
+            }
+            value += vector(k) * columnDot;
+        }
+    }
+    else
+    {
+        for (Eigen::Index k = 0; k < denseMatrix.cols(); ++k)
+        {
+            value += vector(k) * denseMatrix.col(k).dot(vector);
+        }
+    }
+
+    return value;
+}
+
+extern template class QuadraticLineRestriction<Eigen::Dynamic>;
+extern template class QuadraticFunction<Eigen::Dynamic>;
+
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include<cstddef>
+#include<cstdint>
 #include<iostream>
+#include<vector>
 #include<Eigen/Dense>
 
 namespace Optimization
@@ -11,16 +14,71 @@ enum ExitFlag
      Gradient,
      Relative,
      LineSearchFailed,
-     MaxNumIterations
+     MaxNumIterations,
+     TrustRegionFailed
+};
+
+/*
+ *  Returns a short name of the exit flag, e.g. "Gradient", as used by the serializers.
+ */
+
+const char * exitFlagName(ExitFlag exitFlag);
+
+/*
+ *  A switch of an adaptive line search to the line search named lineSearch, taking effect in
+ *  the given iteration, together with the mean evaluation costs in seconds it was based on.
+ */
+
+struct LineSearchDecision
+{
+    unsigned int iteration;
+    const char * lineSearch;
+    double       funcCost;
+    double       gradCost;
 };
 
 class Result 
 {
     public:
-        Result() { }
+        /*
+         *  Fixed layout of the header of a binary record written by writeBinary.
+         *  The header is followed by numParameters doubles holding the optimal parameters.
+         *  All fields are stored in the native byte order of the machine. The field
+         *  hasInitialSteps is one if numAcceptedInitialSteps was counted by the solver, and
+         *  zero otherwise.
+         */
+
+        struct BinaryHeader
+        {
+            std::uint32_t exitFlag;
+            std::uint32_t numIterations;
+            std::uint32_t numFuncEvaluations;
+            std::uint32_t numGradEvaluations;
+            std::uint32_t numAcceptedInitialSteps;
+            std::uint32_t hasInitialSteps;
+            double        optFuncValue;
+            double        optGradNorm;
+            std::uint64_t numParameters;
+        };
+
+    public:
+        Result()
+        :
+        exitFlag(Gradient),
+        optFuncValue(0.0),
+        optGradNorm(0.0),
+        numIterations(0),
+        numFuncEvaluations(0),
+        numGradEvaluations(0),
+        numAcceptedInitialSteps(0),
+        hasInitialSteps(false)
+        {
 
+        }
+
+        template <typename Derived>
         inline void set(const ExitFlag exitFlag,
-                        const Eigen::VectorXd & optParameters,
+                        const Eigen::MatrixBase<Derived> & optParameters,
                         const double optFuncValue,
                         const double optGradNorm,
                         const unsigned int numIterations,
@@ -34,6 +92,129 @@ class Result
             this->numIterations      = numIterations;
             this->numFuncEvaluations = numFuncEvaluations;
             this->numGradEvaluations = numGradEvaluations;
+
+            this->numAcceptedInitialSteps = 0;
+            this->hasInitialSteps         = false;
+
+            // Keeps the capacity, hence repeated solves do not allocate.
+            lineSearchDecisions.clear();
+        }
+
+        /*
+         *  As above, for solvers predicting the trial step length of their line searches with
+         *  an InitialStep strategy, which also count the accepted predictions.
+         */
+
+        template <typename Derived>
+        inline void set(const ExitFlag exitFlag,
+                        const Eigen::MatrixBase<Derived> & optParameters,
+                        const double optFuncValue,
+                        const double optGradNorm,
+                        const unsigned int numIterations,
+                        const unsigned int numFuncEvaluations,
+                        const unsigned int numGradEvaluations,
+                        const unsigned int numAcceptedInitialSteps)
+        {
+            set(exitFlag, optParameters, optFuncValue, optGradNorm, numIterations, numFuncEvaluations, numGradEvaluations);
+
+            this->numAcceptedInitialSteps = numAcceptedInitialSteps;
+            this->hasInitialSteps         = true;
+        }
+
+        inline ExitFlag getExitFlag() const
+        {
+            return exitFlag;
+        }
+
+        inline const Eigen::VectorXd & getOptParameters() const
+        {
+            return optParameters;
+        }
+
+        inline double getOptFuncValue() const
+        {
+            return optFuncValue;
+        }
+
+        inline double getOptGradNorm() const
+        {
+            return optGradNorm;
+        }
+
+        inline unsigned int getNumIterations() const
+        {
+            return numIterations;
+        }
+
+        inline unsigned int getNumFuncEvaluations() const
+        {
+            return numFuncEvaluations;
+        }
+
+        inline unsigned int getNumGradEvaluations() const
+        {
+            return numGradEvaluations;
+        }
+
+        /*
+         *  The number of line searches that accepted the predicted trial step length and their
+         *  fraction of all iterations, which measures the quality of the InitialStep strategy.
+         *  Both are zero and not printed if the solver has no InitialStep strategy.
+         */
+
+        inline bool hasInitialStepStatistics() const
+        {
+            return hasInitialSteps;
+        }
+
+        inline unsigned int getNumAcceptedInitialSteps() const
+        {
+            return numAcceptedInitialSteps;
+        }
+
+        inline double getInitialStepAcceptanceRate() const
+        {
+            return numIterations > 0 ? static_cast<double>(numAcceptedInitialSteps) / numIterations : 0.0;
+        }
+
+        /*
+         *  The decisions of an adaptive line search, see LineSearchAdaptive. They are printed,
+         *  but not serialized.
+         */
+
+        inline void addLineSearchDecision(const LineSearchDecision & decision)
+        {
+            lineSearchDecisions.push_back(decision);
+        }
+
+        inline const std::vector<LineSearchDecision> & getLineSearchDecisions() const
+        {
+            return lineSearchDecisions;
+        }
+
+        /*
+         *  Serializers for bulk runs. Each of them appends a single record to the caller-provided
+         *  buffer without allocating memory and returns the number of bytes written. If the record
+         *  does not fit into the given capacity, zero is returned. The text serializers may then
+         *  have overwritten the buffer with a part of the record, hence its contents are
+         *  unspecified, while writeBinary leaves it untouched. The text records are not
+         *  null-terminated and end with a newline. If the solver does not count the accepted
+         *  initial steps, their number is written as null in JSON and as an empty field in CSV.
+         */
+
+        std::size_t writeJson(char * buffer, std::size_t capacity) const;
+
+        std::size_t writeCsv(char * buffer, std::size_t capacity) const;
+
+        static std::size_t writeCsvHeader(char *                 buffer,
+                                          std::size_t            capacity,
+                                          Eigen::VectorXd::Index numParameters);
+
+        std::size_t writeBinary(char * buffer, std::size_t capacity) const;
+
+        inline std::size_t getBinarySize() const
+        {
+            return sizeof(BinaryHeader) + optParameters.size() * sizeof(double);
         }
 
         friend std::ostream & operator<<(std::ostream & out, 
@@ -47,6 +228,10 @@ class Result
         unsigned int    numIterations;
         unsigned int    numFuncEvaluations;
         unsigned int    numGradEvaluations;
+        unsigned int    numAcceptedInitialSteps;
+        bool            hasInitialSteps;
+
+        std::vector<LineSearchDecision> lineSearchDecisions;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,492 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include <Optimization/Function.hpp>
+#include <Optimization/Result.hpp>
+#include <Optimization/TrustRegionSubproblem.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Hessian approximation policy keeping the symmetric rank-one update of a dense matrix.
+ *  Unlike BFGS, the update does not enforce positive definiteness, hence the approximation
+ *  captures negative curvature and is globalized with a trust region instead of a line search.
+ *  An update is skipped if its denominator is small, see (6.26).
+ */
+
+template <int Dim = Eigen::Dynamic>
+class SR1Policy
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1>   Vector;
+        typedef Eigen::Matrix<double, Dim, Dim> Matrix;
+
+    public:
+        SR1Policy(double skipTol = 1e-8);
+
+        void initialHessian(const Vector & gradient);
+
+        /*
+         *  Updates the approximation with the step s and the change of the gradient y. Returns
+         *  false if the update was skipped.
+         */
+
+        bool updateHessian(const Vector & s,
+                           const Vector & y);
+
+        inline const Matrix & getHessian() const
+        {
+            return hessian;
+        }
+
+        /*
+         *  An update is skipped if |s^T (y - B s)| < skipTol * ||s|| ||y - B s||. The skipTol
+         *  must be in [0, 1). The default value is 1e-8.
+         */
+
+        void setSkipTol(double skipTol);
+        double getSkipTol() const;
+
+    private:
+        double skipTol;
+        bool   firstUpdate;
+
+        Matrix hessian;
+        Vector residual;
+};
+
+/*
+ *  Symmetric rank-one quasi-Newton method with a trust region. Every iteration minimizes the
+ *  quadratic model of the SR1 approximation inside of the trust region, see
+ *  TrustRegionSubproblem, and evaluates the function and its gradient at the trial step.
+ *  The step is accepted if the actual reduction is a sufficient fraction of the predicted
+ *  one, and the radius is adapted to the agreement of model and function. The approximation
+ *  is also updated with rejected trial steps, unless the function increased by far more than
+ *  the model predicted.
+ *
+ *  The solve ends with the exit flag TrustRegionFailed if the radius becomes negligible
+ *  relative to the parameters.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class SR1
+{
+    public:
+        typedef typename Function<Dim>::Vector Vector;
+        typedef typename Function<Dim>::Matrix Matrix;
+
+    public:
+        SR1(Function<Dim> & objFunc,
+            const Vector &  initialParameters,
+            double          gradTol = 1e-9,
+            double          relTol = 1e-9,
+            unsigned int    maxNumIterations = 100000);
+
+        ~SR1();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        unsigned int getNumIterations() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  The radius of the trust region of the first iteration. The default value is 1.
+         */
+
+        void setInitialRadius(double initialRadius);
+        double getInitialRadius() const;
+
+        /*
+         *  A step is accepted if the actual reduction is greater than acceptanceTol times the
+         *  predicted reduction. The acceptanceTol must be in [0, 0.25). The default value is
+         *  1e-4.
+         */
+
+        void setAcceptanceTol(double acceptanceTol);
+        double getAcceptanceTol() const;
+
+        inline SR1Policy<Dim> & getPolicy()
+        {
+            return policy;
+        }
+
+        inline TrustRegionSubproblem<Dim> & getSubproblem()
+        {
+            return subproblem;
+        }
+
+    private:
+        static inline double computeGradNorm(const Vector & gradient)
+        {
+            return gradient.template lpNorm<Eigen::Infinity>();
+        }
+
+    private:
+        Vector                     initialParameters;
+
+        double                     gradTol;
+        double                     relTol;
+        unsigned int               numIterations;
+        unsigned int               maxNumIterations;
+
+        double                     initialRadius;
+        double                     acceptanceTol;
+
+        SR1Policy<Dim>             policy;
+        TrustRegionSubproblem<Dim> subproblem;
+
+        Vector                     parameters;
+        Vector                     gradient;
+        Vector                     trialParameters;
+        Vector                     trialGradient;
+        Vector                     step;
+        Vector                     y;
+
+        Function<Dim> *            objFunc;
+};
+
+template <int Dim>
+SR1Policy<Dim>::SR1Policy(double skipTol)
+                          :
+                          firstUpdate(true)
+{
+    setSkipTol(skipTol);
+}
+
+template <int Dim>
+void SR1Policy<Dim>::initialHessian(const Vector & gradient)
+{
+    const Eigen::Index numParameters = gradient.size();
+
+    hessian.setIdentity(numParameters, numParameters);
+    firstUpdate = true;
+}
+
+/*
+ *  Implements the SR1 update (6.24) with the skipping rule (6.26) from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Pages 144-145
+ *  where the identity is rescaled with y^T y / s^T y before the first update, if this is
+ *  positive, as in (6.20).
+ */
+
+template <int Dim>
+bool SR1Policy<Dim>::updateHessian(const Vector & s,
+                                   const Vector & y)
+{
+    if (firstUpdate)
+    {
+        const double ysInner = y.dot(s);
+        if (ysInner > 0.0)
+        {
+            hessian.setIdentity();
+            hessian *= y.squaredNorm() / ysInner;
+        }
+        firstUpdate = false;
+    }
+
+    residual = y;
+    residual.noalias() -= hessian * s;
+
+    const double denominator = residual.dot(s);
+
+    if (std::fabs(denominator) < skipTol * s.norm() * residual.norm() || denominator == 0.0)
+    {
+        return false;
+    }
+
+    hessian.noalias() += (residual / denominator) * residual.transpose();
+
+    return true;
+}
+
+template <int Dim>
+void SR1Policy<Dim>::setSkipTol(double skipTol)
+{
+    if (skipTol < 0.0 || skipTol >= 1.0)
+    {
+        throw std::invalid_argument("Skip tolerance must be in [0, 1).");
+    }
+
+    this->skipTol = skipTol;
+}
+
+template <int Dim>
+double SR1Policy<Dim>::getSkipTol() const
+{
+    return skipTol;
+}
+
+template <int Dim>
+SR1<Dim>::SR1(Function<Dim> & objFunc,
+              const Vector &  initialParameters,
+              double          gradTol,
+              double          relTol,
+              unsigned int    maxNumIterations)
+{
+    setInitialParameters(initialParameters);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    setMaxNumIterations(maxNumIterations);
+
+    setInitialRadius(1.0);
+    setAcceptanceTol(1e-4);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+SR1<Dim>::~SR1()
+{
+
+}
+
+/*
+ *  Implements the SR1 trust-region Algorithm 6.2 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 146
+ */
+
+template <int Dim>
+void SR1<Dim>::solve(Result & result)
+{
+    double funcValue;
+    double trialFuncValue;
+    double gradNorm;
+
+    parameters = initialParameters;
+    trialGradient.resize(parameters.size());
+
+    numIterations = 0;
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Evaluate the function and its gradient.
+    gradient.resize(parameters.size());
+    objFunc->calcObjFuncValue(parameters, funcValue);
+    objFunc->calcGrad(parameters, gradient);
+
+    // Ensure that the initial parameters are not a minimizer.
+    gradNorm = computeGradNorm(gradient);
+    if (gradNorm <= gradTol)
+    {
+        result.set(Gradient, parameters, funcValue, gradNorm, numIterations,
+                   objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+        return;
+    }
+
+    policy.initialHessian(gradient);
+    double radius = initialRadius;
+
+    while (true)
+    {
+        ++numIterations;
+
+        const double predictedReduction = subproblem.solve(gradient, policy.getHessian(), radius, step);
+
+        trialParameters = parameters + step;
+        objFunc->calcObjFuncValue(trialParameters, trialFuncValue);
+        objFunc->calcGrad(trialParameters, trialGradient);
+
+        const double actualReduction = funcValue - trialFuncValue;
+        const double ratio = (predictedReduction > 0.0) ? actualReduction / predictedReduction : -1.0;
+        const double stepNorm = step.norm();
+
+        // A step on the boundary is limited by the radius rather than by the model.
+        const bool interiorStep = stepNorm < (1.0 - 1e-8) * radius;
+
+        // Adapt the radius to the agreement of the model with the function.
+        if (ratio > 0.75)
+        {
+            if (stepNorm > 0.8 * radius)
+            {
+                radius *= 2.0;
+            }
+        }
+        else if (ratio < 0.1 || !std::isfinite(trialFuncValue))
+        {
+            // Halving the step instead of the radius also shrinks the trust region when the
+            // step was inside of it.
+            radius = 0.5 * stepNorm;
+        }
+
+        // A trial step increasing the function by far more than the model predicted left the
+        // region where the model is valid, e.g. a first step far too long. Its gradient
+        // change would dominate the approximation for the rest of the solve.
+        y = trialGradient - gradient;
+        if (y.allFinite() && actualReduction > -10.0 * predictedReduction)
+        {
+            policy.updateHessian(step, y);
+        }
+
+        if (ratio > acceptanceTol)
+        {
+            const double lastFuncValue = funcValue;
+
+            parameters.swap(trialParameters);
+            gradient.swap(trialGradient);
+            funcValue = trialFuncValue;
+
+            // Gradient convergence test.
+            gradNorm = computeGradNorm(gradient);
+            if (gradNorm <= gradTol)
+            {
+                result.set(Gradient, parameters, funcValue, gradNorm, numIterations,
+                           objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+                return;
+            }
+
+            // Relative convergence test. A small decrease only indicates convergence if the
+            // step was not limited by the radius.
+            if (interiorStep && std::fabs(funcValue - lastFuncValue) <= relTol * std::fabs(funcValue))
+            {
+                result.set(Relative, parameters, funcValue, gradNorm, numIterations,
+                           objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+                return;
+            }
+        }
+
+        // The radius is too small to change the parameters.
+        if (radius <= DBL_EPSILON * std::max(1.0, parameters.norm()))
+        {
+            result.set(TrustRegionFailed, parameters, funcValue, gradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, parameters, funcValue, gradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void SR1<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename SR1<Dim>::Vector & SR1<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+unsigned int SR1<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+void SR1<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int SR1<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+void SR1<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double SR1<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void SR1<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double SR1<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+template <int Dim>
+void SR1<Dim>::setInitialRadius(double initialRadius)
+{
+    if (initialRadius <= 0.0)
+    {
+        throw std::invalid_argument("Initial trust region radius must be greater than zero.");
+    }
+
+    this->initialRadius = initialRadius;
+}
+
+template <int Dim>
+double SR1<Dim>::getInitialRadius() const
+{
+    return initialRadius;
+}
+
+template <int Dim>
+void SR1<Dim>::setAcceptanceTol(double acceptanceTol)
+{
+    if (acceptanceTol < 0.0 || acceptanceTol >= 0.25)
+    {
+        throw std::invalid_argument("Acceptance tolerance must be in [0, 0.25).");
+    }
+
+    this->acceptanceTol = acceptanceTol;
+}
+
+template <int Dim>
+double SR1<Dim>::getAcceptanceTol() const
+{
+    return acceptanceTol;
+}
+
+extern template class SR1Policy<Eigen::Dynamic>;
+extern template class SR1<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <Optimization/BaseAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Direction policy for StaticSolver. Newton's method for large problems with a sparse Hessian,
+ *  which is given by a callable called as hessFunc(parameters, hessValue). It fills the sparse
+ *  matrix hessValue, which keeps its content between the calls, with the same sparsity pattern
+ *  in every call of a solve, e.g. with setFromTriplets in the first call and through coeffRef
+ *  or valuePtr afterwards.
+ *
+ *  The fill-reducing ordering and the symbolic factorization of SimplicialLDLT are computed
+ *  once per solve, in the first iteration. Every further iteration only carries out the
+ *  numeric factorization. The calls of hessFunc are counted as Hessian evaluations of the
+ *  objective function. A Hessian with non-finite entries throws std::invalid_argument.
+ */
+
+template <class Objective>
+class SparseNewtonPolicy
+{
+    public:
+        typedef typename Objective::Vector                                        Vector;
+        typedef Eigen::SparseMatrix<double>                                       SparseMatrix;
+        typedef Callable<void (const Vector & parameters, SparseMatrix & hessValue)> Hessian;
+
+    public:
+        SparseNewtonPolicy(Objective & objFunc,
+                           Hessian     hessFunc,
+                           double      shiftCoeff = 1e-3);
+
+        void initialDirection(const Vector & parameters,
+                              const Vector & gradient,
+                              Vector &       direction);
+
+        void updateDirection(const Vector & parameters,
+                             const Vector & gradient,
+                             const Vector & lastParameters,
+                             const Vector & lastGradient,
+                             Vector &       direction);
+
+        /*
+         *  The smallest multiple of the identity added to an indefinite Hessian, relative to
+         *  the largest magnitude of its diagonal. The default value is 1e-3.
+         */
+
+        void setShiftCoeff(double shiftCoeff);
+        double getShiftCoeff() const;
+
+        /*
+         *  The multiple of the identity added to the last Hessian, zero if it was positive
+         *  definite.
+         */
+
+        inline double getLastShift() const
+        {
+            return shift;
+        }
+
+    private:
+        inline void evalHessian(const Vector & parameters)
+        {
+            hessFunc(parameters, hessian);
+            objFunc->addNumEvaluations(0, 0, 1);
+        }
+
+        bool factorize(double shift);
+
+        void calcDirection(const Vector & parameters,
+                           const Vector & gradient,
+                           Vector &       direction);
+
+    private:
+        Objective *                         objFunc;
+        Hessian                             hessFunc;
+        double                              shiftCoeff;
+        double                              shift;
+
+        SparseMatrix                        hessian;
+        Eigen::SimplicialLDLT<SparseMatrix> cholesky;
+};
+
+/*
+ *  Newton's method with line search for large problems, whose Hessian is sparse and given by
+ *  the user, see SparseNewtonPolicy. An indefinite Hessian is shifted by a multiple of the
+ *  identity as in Newton, and the unit step length is tried first.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class SparseNewton : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector                 Vector;
+        typedef typename SparseNewtonPolicy<Function<Dim>>::Hessian Hessian;
+
+    public:
+        SparseNewton(Function<Dim> &               objFunc,
+                     Hessian                       hessFunc,
+                     const Vector &                initialParameters,
+                     double                        gradTol = 1e-9,
+                     double                        relTol = 1e-9,
+                     unsigned int                  maxNumIterations = 100000,
+                     typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        ~SparseNewton();
+
+        inline void setShiftCoeff(double shiftCoeff)
+        {
+            policy.setShiftCoeff(shiftCoeff);
+        }
+
+        inline double getShiftCoeff() const
+        {
+            return policy.getShiftCoeff();
+        }
+
+    private:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
+    private:
+        SparseNewtonPolicy<Function<Dim>> policy;
+};
+
+template <class Objective>
+SparseNewtonPolicy<Objective>::SparseNewtonPolicy(Objective & objFunc,
+                                                  Hessian     hessFunc,
+                                                  double      shiftCoeff)
+                                                  :
+                                                  objFunc(&objFunc),
+                                                  hessFunc(hessFunc),
+                                                  shift(0.0)
+{
+    setShiftCoeff(shiftCoeff);
+}
+
+template <class Objective>
+void SparseNewtonPolicy<Objective>::initialDirection(const Vector & parameters,
+                                                     const Vector & gradient,
+                                                     Vector &       direction)
+{
+    const Eigen::Index numParameters = parameters.size();
+
+    hessian.resize(numParameters, numParameters);
+    evalHessian(parameters);
+
+    cholesky.analyzePattern(hessian);
+
+    calcDirection(parameters, gradient, direction);
+}
+
+template <class Objective>
+void SparseNewtonPolicy<Objective>::updateDirection(const Vector & parameters,
+                                                    const Vector & gradient,
+                                                    const Vector & lastParameters,
+                                                    const Vector & lastGradient,
+                                                    Vector &       direction)
+{
+    evalHessian(parameters);
+
+    calcDirection(parameters, gradient, direction);
+}
+
+/*
+ *  Factorizes the Hessian plus shift times the identity. The shift is added to the diagonal
+ *  during the factorization, hence the diagonal may be missing from the sparsity pattern.
+ *  Returns false if the sum is not positive definite.
+ */
+
+template <class Objective>
+bool SparseNewtonPolicy<Objective>::factorize(double shift)
+{
+    cholesky.setShift(shift);
+    cholesky.factorize(hessian);
+
+    return cholesky.info() == Eigen::Success && cholesky.vectorD().minCoeff() > 0.0;
+}
+
+/*
+ *  Implements the Cholesky with added multiple of the identity Algorithm 3.3 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 51
+ */
+
+template <class Objective>
+void SparseNewtonPolicy<Objective>::calcDirection(const Vector & parameters,
+                                                  const Vector & gradient,
+                                                  Vector &       direction)
+{
+    shift = 0.0;
+
+    if (!factorize(shift))
+    {
+        // No shift makes a Hessian with non-finite entries positive definite.
+        for (Eigen::Index k = 0; k < hessian.outerSize(); ++k)
+        {
+            for (typename SparseMatrix::InnerIterator it(hessian, k); it; ++it)
+            {
+                if (!std::isfinite(it.value()))
+                {
+                    throw std::invalid_argument("The Hessian is not finite.");
+                }
+            }
+        }
+
+        // The shifts are relative to the scale of the Hessian.
+        const Vector diagonal = hessian.diagonal();
+        const double beta = shiftCoeff * std::max(1.0, diagonal.cwiseAbs().maxCoeff());
+        const double minDiagonal = diagonal.minCoeff();
+
+        shift = (minDiagonal > 0.0) ? beta : beta - minDiagonal;
+
+        while (!factorize(shift))
+        {
+            shift = std::max(2 * shift, beta);
+            if (std::isinf(shift))
+            {
+                throw std::invalid_argument("The Hessian cannot be shifted to be positive definite.");
+            }
+        }
+    }
+
+    direction = cholesky.solve(-gradient);
+}
+
+template <class Objective>
+void SparseNewtonPolicy<Objective>::setShiftCoeff(double shiftCoeff)
+{
+    if (shiftCoeff <= 0.0)
+    {
+        throw std::invalid_argument("The shift coefficient must be greater than zero.");
+    }
+
+    this->shiftCoeff = shiftCoeff;
+}
+
+template <class Objective>
+double SparseNewtonPolicy<Objective>::getShiftCoeff() const
+{
+    return shiftCoeff;
+}
+
+template <int Dim>
+SparseNewton<Dim>::SparseNewton(Function<Dim> &               objFunc,
+                                Hessian                       hessFunc,
+                                const Vector &                initialParameters,
+                                double                        gradTol,
+                                double                        relTol,
+                                unsigned int                  maxNumIterations,
+                                typename LineSearch<Dim>::Ptr lineSearch)
+                                :
+                                BaseAlgorithm<Dim>(objFunc,
+                                                   initialParameters,
+                                                   gradTol,
+                                                   relTol,
+                                                   maxNumIterations,
+                                                   lineSearch),
+                                policy(objFunc,
+                                       hessFunc)
+{
+    this->setInitialStep(std::make_shared<InitialStepUnit<Dim>>());
+}
+
+template <int Dim>
+SparseNewton<Dim>::~SparseNewton()
+{
+
+}
+
+extern template class SparseNewtonPolicy<Function<Eigen::Dynamic>>;
+extern template class SparseNewton<Eigen::Dynamic>;
+
+}
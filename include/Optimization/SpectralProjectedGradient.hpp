@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <Optimization/Function.hpp>
+#include <Optimization/Result.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Spectral projected gradient method. The step length along the negative gradient is the
+ *  Barzilai-Borwein estimate of the inverse curvature along the last step, alternating between
+ *
+ *      BB1 = s^T s / s^T y   and   BB2 = s^T y / y^T y,
+ *
+ *  and is accepted if it decreases the function below the largest of the last function values,
+ *  the nonmonotone rule of Grippo, Lampariello and Lucidi. Hence most iterations cost one
+ *  function and one gradient evaluation, and the state is a few vectors of length n.
+ *
+ *  Optionally the parameters are kept inside of bounds, see setBounds, by projecting every
+ *  gradient step onto them. The gradient tolerance applies to the infinity norm of the
+ *  projected gradient P(x - g) - x, which is also reported as the gradient norm of the result.
+ *  Since single iterations may increase the function, the relative tolerance applies to the
+ *  decrease of the smallest function value over as many iterations as the nonmonotone rule
+ *  looks back.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class SpectralProjectedGradient
+{
+    public:
+        typedef typename Function<Dim>::Vector Vector;
+
+    public:
+        SpectralProjectedGradient(Function<Dim> & objFunc,
+                                  const Vector &  initialParameters,
+                                  double          gradTol = 1e-9,
+                                  double          relTol = 1e-9,
+                                  unsigned int    maxNumIterations = 100000);
+
+        ~SpectralProjectedGradient();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        /*
+         *  Keeps the parameters inside of lowerBounds <= x <= upperBounds. Unbounded parameters
+         *  get infinite bounds. Every lower bound must be less than or equal to the upper bound.
+         */
+
+        void setBounds(const Vector & lowerBounds,
+                       const Vector & upperBounds);
+
+        /*
+         *  Removes the bounds. This is the default.
+         */
+
+        void removeBounds();
+
+        inline bool hasBounds() const
+        {
+            return bounded;
+        }
+
+        unsigned int getNumIterations() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  The number of last function values the sufficient decrease is measured from. One
+         *  gives a monotone method. The default value is 10.
+         */
+
+        void setNonmonotoneMemory(unsigned int nonmonotoneMemory);
+        unsigned int getNonmonotoneMemory() const;
+
+    private:
+        void project(Vector & point) const;
+
+        double computeProjGradNorm();
+
+    private:
+        static constexpr double minStepLength = 1e-30;
+        static constexpr double maxStepLength = 1e30;
+        static constexpr double armijoCoeff   = 1e-4;
+
+        Vector              initialParameters;
+        Vector              lowerBounds;
+        Vector              upperBounds;
+        bool                bounded;
+
+        double              gradTol;
+        double              relTol;
+        unsigned int        numIterations;
+        unsigned int        maxNumIterations;
+        unsigned int        nonmonotoneMemory;
+
+        Vector              parameters;
+        Vector              gradient;
+        Vector              trialParameters;
+        Vector              trialGradient;
+        Vector              direction;
+
+        // Last function values and smallest function values, as ring buffers.
+        std::vector<double> funcValues;
+        std::vector<double> bestFuncValues;
+
+        Function<Dim> *     objFunc;
+};
+
+template <int Dim>
+SpectralProjectedGradient<Dim>::SpectralProjectedGradient(Function<Dim> & objFunc,
+                                                          const Vector &  initialParameters,
+                                                          double          gradTol,
+                                                          double          relTol,
+                                                          unsigned int    maxNumIterations)
+                                                          :
+                                                          bounded(false)
+{
+    setInitialParameters(initialParameters);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    setMaxNumIterations(maxNumIterations);
+    setNonmonotoneMemory(10);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+SpectralProjectedGradient<Dim>::~SpectralProjectedGradient()
+{
+
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::project(Vector & point) const
+{
+    if (bounded)
+    {
+        point = point.cwiseMax(lowerBounds).cwiseMin(upperBounds);
+    }
+}
+
+/*
+ *  Infinity norm of P(x - g) - x, computed in direction.
+ */
+
+template <int Dim>
+double SpectralProjectedGradient<Dim>::computeProjGradNorm()
+{
+    direction = parameters - gradient;
+    project(direction);
+    direction -= parameters;
+
+    return direction.template lpNorm<Eigen::Infinity>();
+}
+
+/*
+ *  Implements the SPG2 algorithm of
+ *  Ernesto G. Birgin, Jose Mario Martinez and Marcos Raydan, Nonmonotone Spectral Projected
+ *  Gradient Methods on Convex Sets, SIAM Journal on Optimization, 10(4), 2000
+ *  with the safeguarded quadratic interpolation on backtracking, and the BB1 and BB2 step
+ *  lengths alternating between the iterations.
+ */
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::solve(Result & result)
+{
+    const Eigen::Index numParameters = initialParameters.size();
+
+    if (bounded && (lowerBounds.size() != numParameters || upperBounds.size() != numParameters))
+    {
+        throw std::invalid_argument("Bounds and initial parameters must have the same size.");
+    }
+
+    double funcValue;
+    double trialFuncValue;
+    double projGradNorm;
+
+    parameters = initialParameters;
+    project(parameters);
+    gradient.resize(numParameters);
+    trialGradient.resize(numParameters);
+
+    numIterations = 0;
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Evaluate the function and its gradient.
+    objFunc->calcObjFuncValue(parameters, funcValue);
+    objFunc->calcGrad(parameters, gradient);
+
+    // Ensure that the initial parameters are not a minimizer.
+    projGradNorm = computeProjGradNorm();
+    if (projGradNorm <= gradTol)
+    {
+        result.set(Gradient, parameters, funcValue, projGradNorm, numIterations,
+                   objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+        return;
+    }
+
+    funcValues.assign(nonmonotoneMemory, funcValue);
+    bestFuncValues.assign(nonmonotoneMemory, funcValue);
+    double bestFuncValue = funcValue;
+
+    // The first step has unit length in the infinity norm.
+    double stepLength = std::min(maxStepLength, std::max(minStepLength, 1.0 / projGradNorm));
+
+    while (true)
+    {
+        ++numIterations;
+
+        // Projected gradient direction
+        direction = parameters - stepLength * gradient;
+        project(direction);
+        direction -= parameters;
+
+        const double gradDotDir = gradient.dot(direction);
+        const double refFuncValue = *std::max_element(funcValues.begin(), funcValues.end());
+
+        // Nonmonotone backtracking
+        double lambda = 1.0;
+        while (true)
+        {
+            trialParameters = parameters + lambda * direction;
+            objFunc->calcObjFuncValue(trialParameters, trialFuncValue);
+
+            if (trialFuncValue <= refFuncValue + armijoCoeff * lambda * gradDotDir)
+            {
+                break;
+            }
+
+            if (lambda * direction.template lpNorm<Eigen::Infinity>() <= DBL_EPSILON * std::max(1.0, parameters.template lpNorm<Eigen::Infinity>()))
+            {
+                result.set(LineSearchFailed, parameters, funcValue, projGradNorm, numIterations,
+                           objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+                return;
+            }
+
+            // Minimizer of the quadratic interpolating f(x), its slope and the trial value,
+            // safeguarded to [0.1, 0.9] times the current lambda.
+            const double curvature = trialFuncValue - funcValue - lambda * gradDotDir;
+            const double interpolated = (curvature > 0.0) ? -0.5 * lambda * lambda * gradDotDir / curvature : 0.0;
+
+            lambda = (interpolated >= 0.1 * lambda && interpolated <= 0.9 * lambda) ? interpolated : 0.5 * lambda;
+        }
+
+        objFunc->calcGrad(trialParameters, trialGradient);
+
+        // Spectral step length from s = trialParameters - parameters and y = the change of the
+        // gradient, which overwrite the old parameters and gradient.
+        parameters.swap(trialParameters);
+        gradient.swap(trialGradient);
+        funcValue = trialFuncValue;
+
+        trialParameters = parameters - trialParameters;
+        trialGradient   = gradient - trialGradient;
+
+        // Without positive curvature along the step the last step length is kept.
+        const double ysInner = trialGradient.dot(trialParameters);
+        if (ysInner > 0.0)
+        {
+            stepLength = (numIterations % 2 == 1) ? trialParameters.squaredNorm() / ysInner
+                                                  : ysInner / trialGradient.squaredNorm();
+            stepLength = std::min(maxStepLength, std::max(minStepLength, stepLength));
+        }
+
+        const unsigned int slot = numIterations % nonmonotoneMemory;
+        const double lastBestFuncValue = bestFuncValues[slot];
+
+        bestFuncValue = std::min(bestFuncValue, funcValue);
+        funcValues[slot] = funcValue;
+        bestFuncValues[slot] = bestFuncValue;
+
+        // Gradient convergence test.
+        projGradNorm = computeProjGradNorm();
+        if (projGradNorm <= gradTol)
+        {
+            result.set(Gradient, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Relative convergence test over the last nonmonotoneMemory iterations.
+        if (numIterations >= nonmonotoneMemory && lastBestFuncValue - bestFuncValue <= relTol * std::fabs(bestFuncValue))
+        {
+            result.set(Relative, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, parameters, funcValue, projGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename SpectralProjectedGradient<Dim>::Vector & SpectralProjectedGradient<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setBounds(const Vector & lowerBounds,
+                                               const Vector & upperBounds)
+{
+    if (lowerBounds.size() != upperBounds.size())
+    {
+        throw std::invalid_argument("Lower and upper bounds must have the same size.");
+    }
+
+    if ((lowerBounds.array() > upperBounds.array()).any())
+    {
+        throw std::invalid_argument("Lower bounds must be less than or equal to upper bounds.");
+    }
+
+    this->lowerBounds = lowerBounds;
+    this->upperBounds = upperBounds;
+    bounded = true;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::removeBounds()
+{
+    bounded = false;
+}
+
+template <int Dim>
+unsigned int SpectralProjectedGradient<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <int Dim>
+unsigned int SpectralProjectedGradient<Dim>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double SpectralProjectedGradient<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double SpectralProjectedGradient<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+template <int Dim>
+void SpectralProjectedGradient<Dim>::setNonmonotoneMemory(unsigned int nonmonotoneMemory)
+{
+    if (nonmonotoneMemory < 1)
+    {
+        throw std::invalid_argument("Nonmonotone memory must be greater than zero.");
+    }
+
+    this->nonmonotoneMemory = nonmonotoneMemory;
+}
+
+template <int Dim>
+unsigned int SpectralProjectedGradient<Dim>::getNonmonotoneMemory() const
+{
+    return nonmonotoneMemory;
+}
+
+extern template class SpectralProjectedGradient<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <Optimization/InitialStep.hpp>
+#include <Optimization/Result.hpp>
+#include <Optimization/Workspace.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Line search descent solver with static dispatch. The objective function, the direction
+ *  policy and the line search policy are template parameters, so that the whole configuration
+ *  compiles into a single loop without virtual calls, e.g.
+ *
+ *      auto objFunc = makeFunction<2>(valueFunctor, gradientFunctor);
+ *      typedef decltype(objFunc) Objective;
+ *      StaticSolver<Objective, BFGSPolicy<2>, LineSearchNocedalPolicy<Objective>> solver(objFunc, initialParameters);
+ *      solver.solve(result);
+ *
+ *  Objective must provide the interface of BasicFunction, Direction the methods initialDirection
+ *  and updateDirection of BaseAlgorithm and Search the method search of LineSearch. Step predicts
+ *  the trial step length of each line search, see InitialStep.hpp.
+ */
+
+template <class Objective, class Direction, class Search, class Step = InitialStepQuadratic<Objective::Vector::RowsAtCompileTime>>
+class StaticSolver
+{
+    public:
+        typedef typename Objective::Vector Vector;
+
+    public:
+        StaticSolver(Objective &    objFunc,
+                     const Vector & initialParameters,
+                     double         gradTol = 1e-9,
+                     double         relTol = 1e-9,
+                     unsigned int   maxNumIterations = 100000);
+
+        StaticSolver(Objective &       objFunc,
+                     const Vector &    initialParameters,
+                     const Direction & direction,
+                     const Search &    lineSearch,
+                     double            gradTol = 1e-9,
+                     double            relTol = 1e-9,
+                     unsigned int      maxNumIterations = 100000);
+
+        void solve(Result & result);
+
+        inline Direction & getDirection()
+        {
+            return direction;
+        }
+
+        inline Search & getLineSearch()
+        {
+            return lineSearch;
+        }
+
+        inline Step & getInitialStep()
+        {
+            return initialStep;
+        }
+
+        inline Workspace<Vector::RowsAtCompileTime> & getWorkspace()
+        {
+            return workspace;
+        }
+
+        inline unsigned int getNumIterations() const
+        {
+            return numIterations;
+        }
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        void setMaxNumIterations(unsigned int maxNumIterations);
+        unsigned int getMaxNumIterations() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+    private:
+        static inline double computeGradNorm(const Vector & gradient)
+        {
+            return gradient.template lpNorm<Eigen::Infinity>();
+        }
+
+    private:
+        Vector       initialParameters;
+        Eigen::Index numParameters;
+
+        double       gradTol;
+        double       relTol;
+        unsigned int numIterations;
+        unsigned int maxNumIterations;
+
+        Direction    direction;
+        Search       lineSearch;
+        Step         initialStep;
+        unsigned int numAcceptedInitialSteps;
+
+        Workspace<Vector::RowsAtCompileTime> workspace;
+
+        Objective *  objFunc;
+};
+
+template <class Objective, class Direction, class Search, class Step>
+StaticSolver<Objective, Direction, Search, Step>::StaticSolver(Objective &    objFunc,
+                                                               const Vector & initialParameters,
+                                                               double         gradTol,
+                                                               double         relTol,
+                                                               unsigned int   maxNumIterations)
+                                                               :
+                                                               StaticSolver(objFunc,
+                                                                            initialParameters,
+                                                                            Direction(),
+                                                                            Search(objFunc),
+                                                                            gradTol,
+                                                                            relTol,
+                                                                            maxNumIterations)
+{
+
+}
+
+template <class Objective, class Direction, class Search, class Step>
+StaticSolver<Objective, Direction, Search, Step>::StaticSolver(Objective &       objFunc,
+                                                               const Vector &    initialParameters,
+                                                               const Direction & direction,
+                                                               const Search &    lineSearch,
+                                                               double            gradTol,
+                                                               double            relTol,
+                                                               unsigned int      maxNumIterations)
+                                                               :
+                                                               direction(direction),
+                                                               lineSearch(lineSearch),
+                                                               initialStep()
+{
+    setInitialParameters(initialParameters);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    numAcceptedInitialSteps = 0;
+    setMaxNumIterations(maxNumIterations);
+
+    this->objFunc = (&objFunc);
+}
+
+template <class Objective, class Direction, class Search, class Step>
+void StaticSolver<Objective, Direction, Search, Step>::solve(Result & result)
+{
+    double funcValue;
+    double lastFuncValue;
+    double gradNorm;
+    double lastGradNorm;
+
+    // Reuse the buffers of the last solve, see Workspace.hpp.
+    workspace.resize(numParameters);
+    workspace.parameters() = initialParameters;
+
+    numIterations = 0;
+    numAcceptedInitialSteps = 0;
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Evaluate the function and its gradient.
+    objFunc->calcObjFuncValue(workspace.parameters(), funcValue);
+    objFunc->calcGrad(workspace.parameters(), workspace.gradient());
+
+    // Ensure that the initial parameters are not a minimizer.
+    gradNorm = computeGradNorm(workspace.gradient());
+    if (gradNorm <= gradTol)
+    {
+        result.set(Gradient, workspace.parameters(), funcValue, gradNorm, numIterations,
+                   objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations(), numAcceptedInitialSteps);
+        return;
+    }
+
+    // Compute the initial direction.
+    direction.initialDirection(workspace.parameters(), workspace.gradient(), workspace.direction());
+
+    double stepLength = initialStep.initialStepLength(workspace.gradient(), workspace.direction());
+
+    while (true)
+    {
+        ++numIterations;
+
+        // Swap the buffers, so that the current iterate becomes the last one and the line search
+        // overwrites the buffers of the previous one.
+        workspace.swap();
+        lastFuncValue = funcValue;
+        lastGradNorm  = gradNorm;
+
+        const double lastGradDotDir = workspace.lastGradient().dot(workspace.direction());
+
+        // Search for an optimal step length.
+        const double trialStepLength = stepLength;
+        const bool stepLengthFound = lineSearch.search(workspace.lastParameters(),
+                                                       workspace.lastGradient(),
+                                                       workspace.direction(),
+                                                       workspace.parameters(),
+                                                       funcValue,
+                                                       workspace.gradient(),
+                                                       stepLength);
+
+        if (!stepLengthFound)
+        {
+            result.set(LineSearchFailed, workspace.lastParameters(), lastFuncValue, lastGradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations(), numAcceptedInitialSteps);
+            return;
+        }
+
+        if (stepLength == trialStepLength)
+        {
+            ++numAcceptedInitialSteps;
+        }
+
+        // Gradient convergence test.
+        gradNorm = computeGradNorm(workspace.gradient());
+        if (gradNorm <= gradTol)
+        {
+            result.set(Gradient, workspace.parameters(), funcValue, gradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations(), numAcceptedInitialSteps);
+            return;
+        }
+
+        // Relative convergence test.
+        if (std::fabs(funcValue - lastFuncValue) <= relTol * std::fabs(funcValue))
+        {
+            result.set(Relative, workspace.parameters(), funcValue, gradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations(), numAcceptedInitialSteps);
+            return;
+        }
+
+        // Check for maximum number of allowed iterations.
+        if (numIterations >= maxNumIterations)
+        {
+            result.set(MaxNumIterations, workspace.parameters(), funcValue, gradNorm, numIterations,
+                       objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations(), numAcceptedInitialSteps);
+            return;
+        }
+
+        // Compute new direction
+        direction.updateDirection(workspace.parameters(),
+                                  workspace.gradient(),
+                                  workspace.lastParameters(),
+                                  workspace.lastGradient(),
+                                  workspace.direction());
+
+        // Predict the trial step length of the next line search.
+        stepLength = initialStep.nextStepLength(workspace.parameters(),
+                                                workspace.gradient(),
+                                                funcValue,
+                                                workspace.lastParameters(),
+                                                workspace.lastGradient(),
+                                                lastFuncValue,
+                                                lastGradDotDir,
+                                                stepLength,
+                                                workspace.direction());
+    }
+}
+
+template <class Objective, class Direction, class Search, class Step>
+void StaticSolver<Objective, Direction, Search, Step>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+    numParameters = initialParameters.size();
+}
+
+template <class Objective, class Direction, class Search, class Step>
+const typename StaticSolver<Objective, Direction, Search, Step>::Vector & StaticSolver<Objective, Direction, Search, Step>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+void StaticSolver<Objective, Direction, Search, Step>::setMaxNumIterations(unsigned int maxNumIterations)
+{
+    if (maxNumIterations < 1)
+    {
+        throw std::invalid_argument("Maximum number of allowed iterations must be greater than zero.");
+    }
+
+    this->maxNumIterations = maxNumIterations;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+unsigned int StaticSolver<Objective, Direction, Search, Step>::getMaxNumIterations() const
+{
+    return maxNumIterations;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+void StaticSolver<Objective, Direction, Search, Step>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+double StaticSolver<Objective, Direction, Search, Step>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+void StaticSolver<Objective, Direction, Search, Step>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <class Objective, class Direction, class Search, class Step>
+double StaticSolver<Objective, Direction, Search, Step>::getRelativeTol() const
+{
+    return relTol;
+}
+
+}
@@ -3,37 +3,99 @@
 #include <Optimization/BaseAlgorithm.hpp>
 
 
-namespace Optimization 
+namespace Optimization
 {
 
-class SteepestDescent : public BaseAlgorithm 
+/*
+ *  Direction policy for StaticSolver.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class SteepestDescentPolicy
 {
     public:
-        SteepestDescent(Function &              objFunc,
-                        const Eigen::VectorXd & initialParameters,
-                        double                  gradTol = 1e-9,
-                        double                  relTol = 1e-9,
-                        unsigned int            maxNumIterations = 100000,
-                        LineSearch::Ptr         lineSearch = nullptr);
-        
-        ~SteepestDescent();
-        
-    private:
-        inline void initialDirection(const Eigen::VectorXd & gradient,
-                                     Eigen::VectorXd &       direction) override
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction)
         {
             direction = -1 * gradient;
         }
 
-        
-        inline void updateDirection(const Eigen::VectorXd & parameters,
-                                    const Eigen::VectorXd & gradient,
-                                    const Eigen::VectorXd & lastParameters,
-                                    const Eigen::VectorXd & lastGradient,
-                                    Eigen::VectorXd &       direction) override
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction)
         {
             direction = -1 * gradient;
         }
 };
 
+template <int Dim = Eigen::Dynamic>
+class SteepestDescent : public BaseAlgorithm<Dim>
+{
+    public:
+        typedef typename BaseAlgorithm<Dim>::Vector Vector;
+
+    public:
+        SteepestDescent(Function<Dim> &               objFunc,
+                        const Vector &                initialParameters,
+                        double                        gradTol = 1e-9,
+                        double                        relTol = 1e-9,
+                        unsigned int                  maxNumIterations = 100000,
+                        typename LineSearch<Dim>::Ptr lineSearch = nullptr);
+
+        ~SteepestDescent();
+
+    private:
+        inline void initialDirection(const Vector & parameters,
+                                     const Vector & gradient,
+                                     Vector &       direction) override
+        {
+            policy.initialDirection(parameters, gradient, direction);
+        }
+
+
+        inline void updateDirection(const Vector & parameters,
+                                    const Vector & gradient,
+                                    const Vector & lastParameters,
+                                    const Vector & lastGradient,
+                                    Vector &       direction) override
+        {
+            policy.updateDirection(parameters, gradient, lastParameters, lastGradient, direction);
+        }
+
+    private:
+        SteepestDescentPolicy<Dim> policy;
+};
+
+template <int Dim>
+SteepestDescent<Dim>::SteepestDescent(Function<Dim> &               objFunc,
+                                      const Vector &                initialParameters,
+                                      double                        gradTol,
+                                      double                        relTol,
+                                      unsigned int                  maxNumIterations,
+                                      typename LineSearch<Dim>::Ptr lineSearch)
+                                      :
+                                      BaseAlgorithm<Dim>(objFunc,
+                                                         initialParameters,
+                                                         gradTol,
+                                                         relTol,
+                                                         maxNumIterations,
+                                                         lineSearch)
+{
+
+}
+
+template <int Dim>
+SteepestDescent<Dim>::~SteepestDescent()
+{
+
+}
+
+extern template class SteepestDescent<Eigen::Dynamic>;
+
 }
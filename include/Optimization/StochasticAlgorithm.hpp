@@ -0,0 +1,498 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <Optimization/Callable.hpp>
+#include <Optimization/Result.hpp>
+#include <Optimization/StochasticFunction.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Learning rate schedules for StochasticAlgorithm, called with the number of updates done.
+ */
+
+class ConstantLearningRate
+{
+    public:
+        ConstantLearningRate(double rate) : rate(rate)
+        {
+            if (rate <= 0.0)
+            {
+                throw std::invalid_argument("Learning rate must be greater than zero.");
+            }
+        }
+
+        inline double operator()(unsigned int /* numIterations */) const
+        {
+            return rate;
+        }
+
+    private:
+        double rate;
+};
+
+/*
+ *  rate / (1 + decay * k) after k updates.
+ */
+
+class InverseTimeLearningRate
+{
+    public:
+        InverseTimeLearningRate(double rate, double decay) : rate(rate), decay(decay)
+        {
+            if (rate <= 0.0 || decay < 0.0)
+            {
+                throw std::invalid_argument("Learning rate must be greater than zero and decay greater than or equal to zero.");
+            }
+        }
+
+        inline double operator()(unsigned int numIterations) const
+        {
+            return rate / (1.0 + decay * numIterations);
+        }
+
+    private:
+        double rate;
+        double decay;
+};
+
+/*
+ *  rate * factor^floor(k / stepSize) after k updates.
+ */
+
+class StepLearningRate
+{
+    public:
+        StepLearningRate(double rate, double factor, unsigned int stepSize) : rate(rate), factor(factor), stepSize(stepSize)
+        {
+            if (rate <= 0.0 || factor <= 0.0 || stepSize < 1)
+            {
+                throw std::invalid_argument("Learning rate, factor and step size must be greater than zero.");
+            }
+        }
+
+        inline double operator()(unsigned int numIterations) const
+        {
+            return rate * std::pow(factor, numIterations / stepSize);
+        }
+
+    private:
+        double       rate;
+        double       factor;
+        unsigned int stepSize;
+};
+
+/*
+ *  Full objective function value and infinity norm of the full gradient after a number of
+ *  epochs, i.e. passes over all samples, and updates.
+ */
+
+struct Checkpoint
+{
+    unsigned int numEpochs;
+    unsigned int numIterations;
+    double       funcValue;
+    double       gradNorm;
+};
+
+/*
+ *  Base class of the mini-batch stochastic gradient methods. Every epoch splits the samples
+ *  of the StochasticFunction into contiguous batches of setBatchSize samples, visits them in
+ *  a random order, see setShuffle and setSeed, and updates the parameters with the gradient
+ *  of each batch and the learning rate of the schedule. There is no line search, so an
+ *  update costs one batch gradient.
+ *
+ *  Every setCheckpointInterval epochs, and after the last one, the full objective function
+ *  and its gradient are evaluated, recorded as a Checkpoint and tested for convergence: the
+ *  gradient tolerance applies to the infinity norm of the full gradient, the relative
+ *  tolerance to the change of the full function value since the last checkpoint. The solve
+ *  ends with MaxNumIterations after maxNumEpochs epochs. The iterations of the result are
+ *  the updates, its evaluations the calls to the callables of the StochasticFunction.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class StochasticAlgorithm
+{
+    public:
+        typedef typename StochasticFunction<Dim>::Vector      Vector;
+        typedef Callable<double (unsigned int numIterations)> LearningRate;
+
+    public:
+        StochasticAlgorithm(StochasticFunction<Dim> & objFunc,
+                            const Vector &            initialParameters,
+                            double                    gradTol,
+                            double                    relTol,
+                            unsigned int              maxNumEpochs,
+                            LearningRate              learningRate);
+
+        virtual ~StochasticAlgorithm();
+
+        void solve(Result & result);
+
+        void setInitialParameters(const Vector & initialParameters);
+        const Vector & getInitialParameters() const;
+
+        unsigned int getNumIterations() const;
+        unsigned int getNumEpochs() const;
+
+        void setMaxNumEpochs(unsigned int maxNumEpochs);
+        unsigned int getMaxNumEpochs() const;
+
+        void setGradientTol(double gradTol);
+        double getGradientTol() const;
+
+        void setRelativeTol(double relTol);
+        double getRelativeTol() const;
+
+        /*
+         *  The learning rate schedule, e.g. ConstantLearningRate, InverseTimeLearningRate,
+         *  StepLearningRate or any callable returning the rate for a number of updates.
+         */
+
+        void setLearningRate(LearningRate learningRate);
+
+        /*
+         *  The number of samples per batch. The last batch of an epoch may be smaller. The
+         *  default value is 32.
+         */
+
+        void setBatchSize(Eigen::Index batchSize);
+        Eigen::Index getBatchSize() const;
+
+        /*
+         *  The number of epochs between checkpoints. The default value is 1.
+         */
+
+        void setCheckpointInterval(unsigned int checkpointInterval);
+        unsigned int getCheckpointInterval() const;
+
+        /*
+         *  Checkpoints of the last solve, starting with the initial parameters.
+         */
+
+        const std::vector<Checkpoint> & getCheckpoints() const;
+
+        /*
+         *  Whether the batches are visited in a random order, drawn from a generator seeded
+         *  with setSeed at the start of each solve. Both are on and zero by default.
+         */
+
+        void setShuffle(bool shuffle);
+        bool getShuffle() const;
+
+        void setSeed(unsigned int seed);
+        unsigned int getSeed() const;
+
+    private:
+        /*
+         *  Resets the state of the method, e.g. momentum or accumulated squared gradients.
+         */
+
+        virtual void initializeState(Eigen::Index numParameters) = 0;
+
+        virtual void updateParameters(const Vector & gradient,
+                                      double         learningRate,
+                                      Vector &       parameters) = 0;
+
+        bool checkpoint(Result & result, ExitFlag exitFlag);
+
+    private:
+        Vector                      initialParameters;
+
+        double                      gradTol;
+        double                      relTol;
+        unsigned int                numIterations;
+        unsigned int                numEpochs;
+        unsigned int                maxNumEpochs;
+        LearningRate                learningRate;
+        Eigen::Index                batchSize;
+        unsigned int                checkpointInterval;
+        bool                        shuffle;
+        unsigned int                seed;
+
+        Vector                      parameters;
+        Vector                      gradient;
+        std::vector<Eigen::Index>   batchOrder;
+        std::vector<Checkpoint>     checkpoints;
+
+        StochasticFunction<Dim> *   objFunc;
+};
+
+template <int Dim>
+StochasticAlgorithm<Dim>::StochasticAlgorithm(StochasticFunction<Dim> & objFunc,
+                                              const Vector &            initialParameters,
+                                              double                    gradTol,
+                                              double                    relTol,
+                                              unsigned int              maxNumEpochs,
+                                              LearningRate              learningRate)
+{
+    setInitialParameters(initialParameters);
+
+    setGradientTol(gradTol);
+    setRelativeTol(relTol);
+
+    numIterations = 0;
+    numEpochs = 0;
+    setMaxNumEpochs(maxNumEpochs);
+    setLearningRate(learningRate);
+
+    setBatchSize(32);
+    setCheckpointInterval(1);
+    setShuffle(true);
+    setSeed(0);
+
+    this->objFunc = (&objFunc);
+}
+
+template <int Dim>
+StochasticAlgorithm<Dim>::~StochasticAlgorithm()
+{
+
+}
+
+/*
+ *  Evaluates the full objective function and gradient, records them and sets the result.
+ *  Returns true if the solve ends, i.e. on convergence or with the given exit flag.
+ */
+
+template <int Dim>
+bool StochasticAlgorithm<Dim>::checkpoint(Result & result, ExitFlag exitFlag)
+{
+    Checkpoint current;
+
+    objFunc->calcObjFuncValue(parameters, current.funcValue);
+    objFunc->calcGrad(parameters, gradient);
+
+    current.numEpochs = numEpochs;
+    current.numIterations = numIterations;
+    current.gradNorm = gradient.template lpNorm<Eigen::Infinity>();
+
+    if (current.gradNorm <= gradTol)
+    {
+        exitFlag = Gradient;
+    }
+    else if (!checkpoints.empty() &&
+             std::fabs(checkpoints.back().funcValue - current.funcValue) <= relTol * std::fabs(current.funcValue))
+    {
+        exitFlag = Relative;
+    }
+
+    checkpoints.push_back(current);
+
+    result.set(exitFlag, parameters, current.funcValue, current.gradNorm, numIterations,
+               objFunc->getNumFuncEvaluations(), objFunc->getNumGradEvaluations());
+
+    return exitFlag != MaxNumIterations || numEpochs >= maxNumEpochs;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::solve(Result & result)
+{
+    const Eigen::Index numSamples = objFunc->getNumSamples();
+    const Eigen::Index numBatches = (numSamples + batchSize - 1) / batchSize;
+
+    parameters = initialParameters;
+    gradient.resize(parameters.size());
+
+    batchOrder.resize(numBatches);
+    std::iota(batchOrder.begin(), batchOrder.end(), 0);
+    std::mt19937 engine(seed);
+
+    initializeState(parameters.size());
+
+    numIterations = 0;
+    numEpochs = 0;
+    checkpoints.clear();
+
+    // Reset counters of function and gradient evaluations.
+    objFunc->resetNumEvaluations();
+
+    // Ensure that the initial parameters are not a minimizer.
+    if (checkpoint(result, MaxNumIterations))
+    {
+        return;
+    }
+
+    while (true)
+    {
+        ++numEpochs;
+
+        if (shuffle)
+        {
+            std::shuffle(batchOrder.begin(), batchOrder.end(), engine);
+        }
+
+        for (const Eigen::Index batch : batchOrder)
+        {
+            const Eigen::Index first = batch * batchSize;
+            const Eigen::Index last = std::min(numSamples, first + batchSize);
+
+            objFunc->calcGrad(parameters, first, last, gradient);
+            updateParameters(gradient, learningRate(numIterations), parameters);
+
+            ++numIterations;
+        }
+
+        if ((numEpochs % checkpointInterval == 0 || numEpochs >= maxNumEpochs) && checkpoint(result, MaxNumIterations))
+        {
+            return;
+        }
+    }
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setInitialParameters(const Vector & initialParameters)
+{
+    this->initialParameters = initialParameters;
+}
+
+template <int Dim>
+const typename StochasticAlgorithm<Dim>::Vector & StochasticAlgorithm<Dim>::getInitialParameters() const
+{
+    return initialParameters;
+}
+
+template <int Dim>
+unsigned int StochasticAlgorithm<Dim>::getNumIterations() const
+{
+    return numIterations;
+}
+
+template <int Dim>
+unsigned int StochasticAlgorithm<Dim>::getNumEpochs() const
+{
+    return numEpochs;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setMaxNumEpochs(unsigned int maxNumEpochs)
+{
+    if (maxNumEpochs < 1)
+    {
+        throw std::invalid_argument("Maximum number of epochs must be greater than zero.");
+    }
+
+    this->maxNumEpochs = maxNumEpochs;
+}
+
+template <int Dim>
+unsigned int StochasticAlgorithm<Dim>::getMaxNumEpochs() const
+{
+    return maxNumEpochs;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setGradientTol(double gradTol)
+{
+    if (gradTol < 0.0)
+    {
+        throw std::invalid_argument("Gradient tolerance must be greater than or equal to zero.");
+    }
+    this->gradTol = gradTol;
+}
+
+template <int Dim>
+double StochasticAlgorithm<Dim>::getGradientTol() const
+{
+    return gradTol;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setRelativeTol(double relTol)
+{
+    if (relTol < 0.0)
+    {
+        throw std::invalid_argument("Relative tolerance must be greater than or equal to zero.");
+    }
+    this->relTol = relTol;
+}
+
+template <int Dim>
+double StochasticAlgorithm<Dim>::getRelativeTol() const
+{
+    return relTol;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setLearningRate(LearningRate learningRate)
+{
+    if (!learningRate)
+    {
+        throw std::invalid_argument("The learning rate schedule must not be empty.");
+    }
+    this->learningRate = learningRate;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setBatchSize(Eigen::Index batchSize)
+{
+    if (batchSize < 1)
+    {
+        throw std::invalid_argument("Batch size must be greater than zero.");
+    }
+    this->batchSize = batchSize;
+}
+
+template <int Dim>
+Eigen::Index StochasticAlgorithm<Dim>::getBatchSize() const
+{
+    return batchSize;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setCheckpointInterval(unsigned int checkpointInterval)
+{
+    if (checkpointInterval < 1)
+    {
+        throw std::invalid_argument("Checkpoint interval must be greater than zero.");
+    }
+    this->checkpointInterval = checkpointInterval;
+}
+
+template <int Dim>
+unsigned int StochasticAlgorithm<Dim>::getCheckpointInterval() const
+{
+    return checkpointInterval;
+}
+
+template <int Dim>
+const std::vector<Checkpoint> & StochasticAlgorithm<Dim>::getCheckpoints() const
+{
+    return checkpoints;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setShuffle(bool shuffle)
+{
+    this->shuffle = shuffle;
+}
+
+template <int Dim>
+bool StochasticAlgorithm<Dim>::getShuffle() const
+{
+    return shuffle;
+}
+
+template <int Dim>
+void StochasticAlgorithm<Dim>::setSeed(unsigned int seed)
+{
+    this->seed = seed;
+}
+
+template <int Dim>
+unsigned int StochasticAlgorithm<Dim>::getSeed() const
+{
+    return seed;
+}
+
+extern template class StochasticAlgorithm<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <Optimization/Callable.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Objective function given as the mean over samples,
+ *
+ *      F(x) = 1 / N sum_{i=0}^{N-1} f_i(x),
+ *
+ *  e.g. the empirical risk of a model over N training samples. The callables evaluate the
+ *  sum over the contiguous sample range [first, last) and are called as
+ *  objFunc(parameters, first, last, objFuncValue) and gradFunc(parameters, first, last,
+ *  gradValue), where gradValue is already sized. Mini-batches are such ranges, hence the
+ *  user keeps the samples in an order that makes every range a representative batch,
+ *  e.g. shuffled once up front. The methods of this class return means over the range.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class StochasticFunction
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1>                                                                            Vector;
+        typedef Callable<void (const Vector & parameters, Eigen::Index first, Eigen::Index last, double & objFuncValue)> Value;
+        typedef Callable<void (const Vector & parameters, Eigen::Index first, Eigen::Index last, Vector & gradValue)>    Gradient;
+
+    public:
+        StochasticFunction(Eigen::Index numSamples,
+                           Value        objFunc,
+                           Gradient     gradFunc);
+
+        inline Eigen::Index getNumSamples() const
+        {
+            return numSamples;
+        }
+
+        /*
+         *  Mean of the objective function over the samples [first, last).
+         */
+
+        inline void calcObjFuncValue(const Vector & parameters,
+                                     Eigen::Index   first,
+                                     Eigen::Index   last,
+                                     double &       objFuncValue)
+        {
+            ++numFuncEvaluations;
+            numFuncSamples += last - first;
+
+            objFunc(parameters, first, last, objFuncValue);
+            objFuncValue /= static_cast<double>(last - first);
+        }
+
+        /*
+         *  Mean of the objective function over all samples.
+         */
+
+        inline void calcObjFuncValue(const Vector & parameters,
+                                     double &       objFuncValue)
+        {
+            calcObjFuncValue(parameters, 0, numSamples, objFuncValue);
+        }
+
+        /*
+         *  Mean of the gradient over the samples [first, last), sized to the parameters.
+         */
+
+        inline void calcGrad(const Vector & parameters,
+                             Eigen::Index   first,
+                             Eigen::Index   last,
+                             Vector &       gradValue)
+        {
+            ++numGradEvaluations;
+            numGradSamples += last - first;
+
+            gradValue.resize(parameters.size());
+            gradFunc(parameters, first, last, gradValue);
+            gradValue /= static_cast<double>(last - first);
+        }
+
+        /*
+         *  Mean of the gradient over all samples.
+         */
+
+        inline void calcGrad(const Vector & parameters,
+                             Vector &       gradValue)
+        {
+            calcGrad(parameters, 0, numSamples, gradValue);
+        }
+
+        /*
+         *  Counters of the calls to the callables and of the samples evaluated by them.
+         */
+
+        inline unsigned int getNumFuncEvaluations() const
+        {
+            return numFuncEvaluations;
+        }
+
+        inline unsigned int getNumGradEvaluations() const
+        {
+            return numGradEvaluations;
+        }
+
+        inline unsigned long long getNumFuncSamples() const
+        {
+            return numFuncSamples;
+        }
+
+        inline unsigned long long getNumGradSamples() const
+        {
+            return numGradSamples;
+        }
+
+        inline void resetNumEvaluations()
+        {
+            numFuncEvaluations = 0;
+            numGradEvaluations = 0;
+            numFuncSamples = 0;
+            numGradSamples = 0;
+        }
+
+    private:
+        Eigen::Index       numSamples;
+        Value              objFunc;
+        Gradient           gradFunc;
+
+        unsigned int       numFuncEvaluations;
+        unsigned int       numGradEvaluations;
+        unsigned long long numFuncSamples;
+        unsigned long long numGradSamples;
+};
+
+template <int Dim>
+StochasticFunction<Dim>::StochasticFunction(Eigen::Index numSamples,
+                                            Value        objFunc,
+                                            Gradient     gradFunc)
+                                            :
+                                            objFunc(objFunc),
+                                            gradFunc(gradFunc)
+{
+    if (numSamples < 1)
+    {
+        throw std::invalid_argument("Number of samples must be greater than zero.");
+    }
+
+    if (!this->objFunc || !this->gradFunc)
+    {
+        throw std::invalid_argument("Objective function and gradient callables must not be empty.");
+    }
+
+    this->numSamples = numSamples;
+    resetNumEvaluations();
+}
+
+extern template class StochasticFunction<Eigen::Dynamic>;
+
+}
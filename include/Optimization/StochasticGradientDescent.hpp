@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <Optimization/StochasticAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Mini-batch stochastic gradient descent with momentum,
+ *
+ *      v = momentum v - learningRate g,   x = x + v,
+ *
+ *  where g is the mean gradient of a batch. Without momentum it is plain stochastic gradient
+ *  descent. The default learning rate is a constant 0.01.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class StochasticGradientDescent : public StochasticAlgorithm<Dim>
+{
+    public:
+        typedef typename StochasticAlgorithm<Dim>::Vector       Vector;
+        typedef typename StochasticAlgorithm<Dim>::LearningRate LearningRate;
+
+    public:
+        StochasticGradientDescent(StochasticFunction<Dim> & objFunc,
+                                  const Vector &            initialParameters,
+                                  double                    gradTol = 1e-9,
+                                  double                    relTol = 1e-9,
+                                  unsigned int              maxNumEpochs = 100,
+                                  LearningRate              learningRate = ConstantLearningRate(0.01));
+
+        ~StochasticGradientDescent();
+
+        /*
+         *  The momentum coefficient in [0, 1). The default value is 0.9.
+         */
+
+        void setMomentum(double momentum);
+        double getMomentum() const;
+
+    private:
+        void initializeState(Eigen::Index numParameters) override;
+
+        void updateParameters(const Vector & gradient,
+                              double         learningRate,
+                              Vector &       parameters) override;
+
+    private:
+        double momentum;
+        Vector velocity;
+};
+
+template <int Dim>
+StochasticGradientDescent<Dim>::StochasticGradientDescent(StochasticFunction<Dim> & objFunc,
+                                                          const Vector &            initialParameters,
+                                                          double                    gradTol,
+                                                          double                    relTol,
+                                                          unsigned int              maxNumEpochs,
+                                                          LearningRate              learningRate)
+                                                          :
+                                                          StochasticAlgorithm<Dim>(objFunc,
+                                                                                   initialParameters,
+                                                                                   gradTol,
+                                                                                   relTol,
+                                                                                   maxNumEpochs,
+                                                                                   learningRate)
+{
+    setMomentum(0.9);
+}
+
+template <int Dim>
+StochasticGradientDescent<Dim>::~StochasticGradientDescent()
+{
+
+}
+
+template <int Dim>
+void StochasticGradientDescent<Dim>::initializeState(Eigen::Index numParameters)
+{
+    velocity.setZero(numParameters);
+}
+
+template <int Dim>
+void StochasticGradientDescent<Dim>::updateParameters(const Vector & gradient,
+                                                      double         learningRate,
+                                                      Vector &       parameters)
+{
+    velocity = momentum * velocity - learningRate * gradient;
+    parameters += velocity;
+}
+
+template <int Dim>
+void StochasticGradientDescent<Dim>::setMomentum(double momentum)
+{
+    if (momentum < 0.0 || momentum >= 1.0)
+    {
+        throw std::invalid_argument("Momentum must be in [0, 1).");
+    }
+    this->momentum = momentum;
+}
+
+template <int Dim>
+double StochasticGradientDescent<Dim>::getMomentum() const
+{
+    return momentum;
+}
+
+extern template class StochasticGradientDescent<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Optimization/Callable.hpp>
+
+
+namespace Optimization
+{
+
+/*
+ *  Fixed set of worker threads running the tasks of a parallel loop. The calling thread
+ *  takes part in the loop, hence a pool of numThreads threads starts numThreads - 1
+ *  workers and a pool of a single thread runs everything serially on the caller.
+ *  The tasks must not throw.
+ */
+
+class ThreadPool
+{
+    public:
+        typedef Callable<void (unsigned int index)> Task;
+
+    public:
+        explicit ThreadPool(unsigned int numThreads = std::thread::hardware_concurrency());
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool();
+
+        /*
+         *  Calls task(index) for every index in [0, numTasks) and returns when all calls
+         *  have finished. The order of the calls is unspecified.
+         */
+
+        void run(unsigned int numTasks,
+                 Task         task);
+
+        unsigned int getNumThreads() const;
+
+    private:
+        void work();
+        void execute();
+
+    private:
+        std::vector<std::thread>  workers;
+
+        std::mutex                mutex;
+        std::condition_variable   wakeUp;
+        std::condition_variable   finished;
+
+        Task *                    task;
+        unsigned int              numTasks;
+        std::atomic<unsigned int> nextTask;
+        unsigned int              numFinishedTasks;
+        unsigned int              numBusyWorkers;
+        unsigned int              generation;
+        bool                      stop;
+};
+
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+
+
+namespace Optimization
+{
+
+/*
+ *  Solver of the trust-region subproblem
+ *
+ *      min m(p) = g^T p + 0.5 p^T B p   subject to   ||p|| <= radius
+ *
+ *  for a symmetric, possibly indefinite, matrix B. Up to maxNumExactParameters parameters it
+ *  is solved exactly from an eigendecomposition of B, which costs O(n^3). For more parameters
+ *  it is solved approximately with the conjugate gradient method of Steihaug, which costs
+ *  O(n^2) per iteration and stops at the boundary or at a direction of negative curvature.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class TrustRegionSubproblem
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1>   Vector;
+        typedef Eigen::Matrix<double, Dim, Dim> Matrix;
+
+    public:
+        TrustRegionSubproblem(unsigned int maxNumExactParameters = 100);
+
+        /*
+         *  Computes the step and returns the predicted reduction -m(step), which is positive
+         *  unless the gradient vanishes.
+         */
+
+        double solve(const Vector & gradient,
+                     const Matrix & hessian,
+                     double         radius,
+                     Vector &       step);
+
+        /*
+         *  The largest number of parameters for which the subproblem is solved exactly. The
+         *  default value is 100.
+         */
+
+        void setMaxNumExactParameters(unsigned int maxNumExactParameters);
+        unsigned int getMaxNumExactParameters() const;
+
+    private:
+        void solveExact(const Vector & gradient,
+                        const Matrix & hessian,
+                        double         radius,
+                        Vector &       step);
+
+        void solveSteihaug(const Vector & gradient,
+                           const Matrix & hessian,
+                           double         radius,
+                           Vector &       step);
+
+        double calcStepNorm(double multiplier, double & derivative) const;
+
+        static double calcBoundaryStep(const Vector & step,
+                                       const Vector & direction,
+                                       double         radius);
+
+    private:
+        unsigned int                          maxNumExactParameters;
+
+        Eigen::SelfAdjointEigenSolver<Matrix> eigenSolver;
+        Vector                                gradHat;
+        Vector                                coeffs;
+
+        Vector                                residual;
+        Vector                                direction;
+        Vector                                hessDir;
+};
+
+template <int Dim>
+TrustRegionSubproblem<Dim>::TrustRegionSubproblem(unsigned int maxNumExactParameters)
+{
+    setMaxNumExactParameters(maxNumExactParameters);
+}
+
+template <int Dim>
+double TrustRegionSubproblem<Dim>::solve(const Vector & gradient,
+                                         const Matrix & hessian,
+                                         double         radius,
+                                         Vector &       step)
+{
+    if (radius <= 0.0)
+    {
+        throw std::invalid_argument("Trust region radius must be greater than zero.");
+    }
+
+    if (gradient.size() <= static_cast<Eigen::Index>(maxNumExactParameters))
+    {
+        solveExact(gradient, hessian, radius, step);
+    }
+    else
+    {
+        solveSteihaug(gradient, hessian, radius, step);
+    }
+
+    hessDir.noalias() = hessian * step;
+
+    return -(gradient.dot(step) + 0.5 * step.dot(hessDir));
+}
+
+/*
+ *  Norm of the step for the given Lagrange multiplier in the eigenbasis of the Hessian,
+ *  together with the derivative of the norm with respect to the multiplier.
+ */
+
+template <int Dim>
+double TrustRegionSubproblem<Dim>::calcStepNorm(double multiplier, double & derivative) const
+{
+    const auto shifted = eigenSolver.eigenvalues().array() + multiplier;
+    const double normSquared = (gradHat.array() / shifted).square().sum();
+    const double norm = std::sqrt(normSquared);
+
+    derivative = -(gradHat.array().square() / shifted.cube()).sum() / norm;
+
+    return norm;
+}
+
+/*
+ *  Implements the characterization of Theorem 4.1 with the Newton iteration of Algorithm 4.3
+ *  on the secular equation and the hard case (4.45) from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Pages 84-88
+ *  where the Cholesky factorizations are replaced by one eigendecomposition, so every Newton
+ *  iteration costs O(n). The Newton iteration is safeguarded by bisection.
+ */
+
+template <int Dim>
+void TrustRegionSubproblem<Dim>::solveExact(const Vector & gradient,
+                                            const Matrix & hessian,
+                                            double         radius,
+                                            Vector &       step)
+{
+    eigenSolver.compute(hessian);
+
+    const Vector & eigenvalues = eigenSolver.eigenvalues();
+    const Matrix & eigenvectors = eigenSolver.eigenvectors();
+    const double minEigenvalue = eigenvalues(0);
+
+    gradHat.noalias() = eigenvectors.transpose() * gradient;
+
+    // The Newton step is taken if it is inside of the trust region.
+    if (minEigenvalue > 0.0)
+    {
+        coeffs = gradHat.cwiseQuotient(eigenvalues);
+        if (coeffs.norm() <= radius)
+        {
+            step.noalias() = -eigenvectors * coeffs;
+            return;
+        }
+    }
+
+    const double lowerBound = std::max(0.0, -minEigenvalue);
+    const double gradNorm = gradHat.norm();
+
+    // Hard case: the gradient is orthogonal to the eigenspace of the smallest eigenvalue and
+    // the step of the smallest admissible multiplier is inside of the trust region.
+    const double eigenvalueTol = std::sqrt(DBL_EPSILON) * std::max(1.0, eigenvalues.cwiseAbs().maxCoeff());
+    const double gradTol = std::sqrt(DBL_EPSILON) * gradNorm;
+
+    double minGradHatSquared = 0.0;
+    for (Eigen::Index i = 0; i < eigenvalues.size() && eigenvalues(i) - minEigenvalue <= eigenvalueTol; ++i)
+    {
+        minGradHatSquared += gradHat(i) * gradHat(i);
+    }
+
+    if (minEigenvalue <= 0.0 && minGradHatSquared <= gradTol * gradTol)
+    {
+        coeffs.resize(eigenvalues.size());
+        for (Eigen::Index i = 0; i < eigenvalues.size(); ++i)
+        {
+            const double shifted = eigenvalues(i) - minEigenvalue;
+            coeffs(i) = (shifted <= eigenvalueTol) ? 0.0 : gradHat(i) / shifted;
+        }
+
+        const double coeffsNorm = coeffs.norm();
+        if (coeffsNorm <= radius)
+        {
+            // Move along the eigenvector of the smallest eigenvalue to the boundary.
+            step.noalias() = -eigenvectors * coeffs;
+            step += std::sqrt(radius * radius - coeffsNorm * coeffsNorm) * eigenvectors.col(0);
+            return;
+        }
+    }
+
+    // The norm of the step decreases with the multiplier from infinity at the lower bound
+    // to radius at the upper bound.
+    double low = lowerBound;
+    double high = lowerBound + gradNorm / radius;
+    double multiplier = (minEigenvalue > 0.0) ? 0.0 : 0.5 * (low + high);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        double derivative;
+        const double stepNorm = calcStepNorm(multiplier, derivative);
+
+        if (std::fabs(stepNorm - radius) <= 1e-10 * radius)
+        {
+            break;
+        }
+
+        if (stepNorm > radius)
+        {
+            low = multiplier;
+        }
+        else
+        {
+            high = multiplier;
+        }
+
+        // Newton step on 1 / radius - 1 / ||p||, which is almost linear in the multiplier.
+        const double newton = multiplier - (stepNorm - radius) * stepNorm / (radius * derivative);
+
+        multiplier = (newton > low && newton < high) ? newton : 0.5 * (low + high);
+
+        if (high - low <= DBL_EPSILON * high)
+        {
+            break;
+        }
+    }
+
+    coeffs = gradHat.array() / (eigenvalues.array() + multiplier);
+    step.noalias() = -eigenvectors * coeffs;
+}
+
+/*
+ *  Implements the CG-Steihaug Algorithm 7.2 from
+ *  Jorge Nocedal and Stephen J. Wright, Numerical Optimization,
+ *  Springer, 2nd edition, 2006, Page 171
+ */
+
+template <int Dim>
+void TrustRegionSubproblem<Dim>::solveSteihaug(const Vector & gradient,
+                                               const Matrix & hessian,
+                                               double         radius,
+                                               Vector &       step)
+{
+    const Eigen::Index numParameters = gradient.size();
+    const double gradNorm = gradient.norm();
+    const double tol = std::min(0.5, std::sqrt(gradNorm)) * gradNorm;
+
+    step.setZero(numParameters);
+    residual = gradient;
+    direction = -gradient;
+
+    if (gradNorm <= tol)
+    {
+        return;
+    }
+
+    double residualNormSquared = residual.squaredNorm();
+
+    for (Eigen::Index j = 0; j < numParameters; ++j)
+    {
+        hessDir.noalias() = hessian * direction;
+        const double curvature = direction.dot(hessDir);
+
+        if (curvature <= 0.0)
+        {
+            // Follow the direction of negative curvature to the boundary.
+            step += calcBoundaryStep(step, direction, radius) * direction;
+            return;
+        }
+
+        const double alpha = residualNormSquared / curvature;
+
+        if ((step + alpha * direction).norm() >= radius)
+        {
+            step += calcBoundaryStep(step, direction, radius) * direction;
+            return;
+        }
+
+        step += alpha * direction;
+        residual += alpha * hessDir;
+
+        const double nextResidualNormSquared = residual.squaredNorm();
+        if (std::sqrt(nextResidualNormSquared) < tol)
+        {
+            return;
+        }
+
+        direction = (nextResidualNormSquared / residualNormSquared) * direction - residual;
+        residualNormSquared = nextResidualNormSquared;
+    }
+}
+
+/*
+ *  The nonnegative tau with ||step + tau * direction|| = radius for a step inside of the
+ *  trust region.
+ */
+
+template <int Dim>
+double TrustRegionSubproblem<Dim>::calcBoundaryStep(const Vector & step,
+                                                    const Vector & direction,
+                                                    double         radius)
+{
+    const double a = direction.squaredNorm();
+    const double b = step.dot(direction);
+    const double c = step.squaredNorm() - radius * radius;
+
+    return (-b + std::sqrt(std::max(0.0, b * b - a * c))) / a;
+}
+
+template <int Dim>
+void TrustRegionSubproblem<Dim>::setMaxNumExactParameters(unsigned int maxNumExactParameters)
+{
+    this->maxNumExactParameters = maxNumExactParameters;
+}
+
+template <int Dim>
+unsigned int TrustRegionSubproblem<Dim>::getMaxNumExactParameters() const
+{
+    return maxNumExactParameters;
+}
+
+extern template class TrustRegionSubproblem<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <utility>
+
+#include <Eigen/Dense>
+
+
+namespace Optimization
+{
+
+/*
+ *  Holds the iterate state of a solver. The buffers are sized once by resize and reused by
+ *  every later solve of the same dimension, so the iterations do not allocate. The current and
+ *  the last iterate live in two buffers whose roles are swapped at each iteration instead of
+ *  copying the iterate.
+ */
+
+template <int Dim = Eigen::Dynamic>
+class Workspace
+{
+    public:
+        typedef Eigen::Matrix<double, Dim, 1> Vector;
+
+    public:
+        Workspace() : current(0) { }
+
+        inline void resize(Eigen::Index numParameters)
+        {
+            // Resizing to the current size is a no-op in Eigen.
+            for (int i = 0; i < 2; ++i)
+            {
+                parametersBuffer[i].resize(numParameters);
+                gradientBuffer[i].resize(numParameters);
+            }
+            directionBuffer.resize(numParameters);
+        }
+
+        inline void swap()
+        {
+            current = 1 - current;
+        }
+
+        inline Vector & parameters()
+        {
+            return parametersBuffer[current];
+        }
+
+        inline Vector & lastParameters()
+        {
+            return parametersBuffer[1 - current];
+        }
+
+        inline Vector & gradient()
+        {
+            return gradientBuffer[current];
+        }
+
+        inline Vector & lastGradient()
+        {
+            return gradientBuffer[1 - current];
+        }
+
+        inline Vector & direction()
+        {
+            return directionBuffer;
+        }
+
+    private:
+        Vector parametersBuffer[2];
+        Vector gradientBuffer[2];
+        Vector directionBuffer;
+        int    current;
+};
+
+}
@@ -0,0 +1,9 @@
+#include <Optimization/AdaGrad.hpp>
+
+
+namespace Optimization
+{
+
+template class AdaGrad<Eigen::Dynamic>;
+
+}
\ No newline at end of file
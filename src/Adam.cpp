@@ -0,0 +1,9 @@
+#include <Optimization/Adam.hpp>
+
+
+namespace Optimization
+{
+
+template class Adam<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/CompactLBFGS.hpp>
+
+
+namespace Optimization
+{
+
+template class CompactLBFGS<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/CompositeFunction.hpp>
+
+
+namespace Optimization
+{
+
+template class CompositeFunction<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/ConjugateGradient.hpp>
+
+
+namespace Optimization
+{
+
+template class ConjugateGradientPolicy<Eigen::Dynamic>;
+template class ConjugateGradient<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/FISTA.hpp>
+
+
+namespace Optimization
+{
+
+template class FISTA<Eigen::Dynamic>;
+
+}
\ No newline at end of file
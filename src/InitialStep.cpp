@@ -0,0 +1,14 @@
+#include <Optimization/InitialStep.hpp>
+
+
+namespace Optimization
+{
+
+template class InitialStep<Eigen::Dynamic>;
+template class InitialStepUnit<Eigen::Dynamic>;
+template class InitialStepShannoPhua<Eigen::Dynamic>;
+template class InitialStepQuadratic<Eigen::Dynamic>;
+template class InitialStepRatio<Eigen::Dynamic>;
+template class InitialStepBarzilaiBorwein<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/LBFGS.hpp>
+
+
+namespace Optimization
+{
+
+template class LBFGSPolicy<Eigen::Dynamic>;
+template class LBFGS<Eigen::Dynamic>;
+
+}
\ No newline at end of file
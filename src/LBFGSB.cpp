@@ -0,0 +1,9 @@
+#include <Optimization/LBFGSB.hpp>
+
+
+namespace Optimization
+{
+
+template class LBFGSB<Eigen::Dynamic>;
+
+}
\ No newline at end of file
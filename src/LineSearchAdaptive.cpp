@@ -0,0 +1,9 @@
+#include <Optimization/LineSearchAdaptive.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchAdaptive<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/LineSearchBrent.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchBrentPolicy<Function<Eigen::Dynamic>>;
+template class LineSearchBrent<Eigen::Dynamic>;
+
+}
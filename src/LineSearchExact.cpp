@@ -0,0 +1,10 @@
+#include <Optimization/LineSearchExact.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchExactPolicy<QuadraticFunction<Eigen::Dynamic>>;
+template class LineSearchExact<Eigen::Dynamic>;
+
+}
\ No newline at end of file
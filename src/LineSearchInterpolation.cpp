@@ -0,0 +1,10 @@
+#include <Optimization/LineSearchInterpolation.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchInterpolationPolicy<Function<Eigen::Dynamic>>;
+template class LineSearchInterpolation<Eigen::Dynamic>;
+
+}
\ No newline at end of file
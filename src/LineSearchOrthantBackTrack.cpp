@@ -0,0 +1,9 @@
+#include <Optimization/LineSearchOrthantBackTrack.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchOrthantBackTrack<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/LineSearchParallel.hpp>
+
+
+namespace Optimization
+{
+
+template class LineSearchParallelPolicy<Function<Eigen::Dynamic>>;
+template class LineSearchParallel<Eigen::Dynamic>;
+
+}
@@ -0,0 +1,10 @@
+#include <Optimization/Newton.hpp>
+
+
+namespace Optimization
+{
+
+template class NewtonPolicy<Function<Eigen::Dynamic>>;
+template class Newton<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/OWLQN.hpp>
+
+
+namespace Optimization
+{
+
+template class OWLQN<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/QuadraticFunction.hpp>
+
+
+namespace Optimization
+{
+
+template class QuadraticLineRestriction<Eigen::Dynamic>;
+template class QuadraticFunction<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -1,8 +1,201 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
 #include <Optimization/Result.hpp>
 
 namespace Optimization
 {
 
+namespace
+{
+
+/*
+ *  Appends formatted text to a fixed-capacity buffer. Once a piece does not fit,
+ *  the writer is marked as failed and every later append is ignored.
+ */
+
+class TextWriter
+{
+    public:
+        TextWriter(char * buffer, std::size_t capacity)
+        :
+        buffer(buffer), capacity(capacity), size(0), failed(false)
+        {
+
+        }
+
+        template <typename... Args>
+        void append(const char * format, Args... args)
+        {
+            if (failed)
+            {
+                return;
+            }
+
+            // The null terminator written by snprintf is overwritten by the next append.
+            const std::size_t available = capacity - size;
+            const int length = std::snprintf(buffer + size, available, format, args...);
+            if (length < 0 || static_cast<std::size_t>(length) >= available)
+            {
+                failed = true;
+                return;
+            }
+            size += length;
+        }
+
+        void appendDouble(double value, bool json)
+        {
+            // JSON has no representation for NaN or infinity.
+            if (json && !std::isfinite(value))
+            {
+                append("null");
+            }
+            else
+            {
+                append("%.17g", value);
+            }
+        }
+
+        std::size_t finish()
+        {
+            // Reserve room for the trailing newline, which is not followed by a null terminator.
+            if (failed || size >= capacity)
+            {
+                return 0;
+            }
+            buffer[size++] = '\n';
+
+            return size;
+        }
+
+    private:
+        char *      buffer;
+        std::size_t capacity;
+        std::size_t size;
+        bool        failed;
+};
+
+}
+
+const char * exitFlagName(ExitFlag exitFlag)
+{
+    switch (exitFlag)
+    {
+        case Gradient:
+            return "Gradient";
+        case Relative:
+            return "Relative";
+        case LineSearchFailed:
+            return "LineSearchFailed";
+        case MaxNumIterations:
+            return "MaxNumIterations";
+        case TrustRegionFailed:
+            return "TrustRegionFailed";
+    }
+
+    return "Unknown";
+}
+
+std::size_t Result::writeJson(char * buffer, std::size_t capacity) const
+{
+    TextWriter writer(buffer, capacity);
+
+    writer.append("{\"exitFlag\":\"%s\",\"optFuncValue\":", exitFlagName(exitFlag));
+    writer.appendDouble(optFuncValue, true);
+    writer.append(",\"optGradNorm\":");
+    writer.appendDouble(optGradNorm, true);
+    writer.append(",\"numIterations\":%u,\"numFuncEvaluations\":%u,\"numGradEvaluations\":%u,\"numAcceptedInitialSteps\":",
+                  numIterations, numFuncEvaluations, numGradEvaluations);
+    // Null if the solver does not count them, as opposed to zero accepted steps.
+    if (hasInitialSteps)
+    {
+        writer.append("%u", numAcceptedInitialSteps);
+    }
+    else
+    {
+        writer.append("null");
+    }
+    writer.append(",\"optParameters\":[");
+    for (Eigen::VectorXd::Index i = 0; i < optParameters.size(); ++i)
+    {
+        if (i > 0)
+        {
+            writer.append(",");
+        }
+        writer.appendDouble(optParameters(i), true);
+    }
+    writer.append("]}");
+
+    return writer.finish();
+}
+
+std::size_t Result::writeCsv(char * buffer, std::size_t capacity) const
+{
+    TextWriter writer(buffer, capacity);
+
+    writer.append("%s,", exitFlagName(exitFlag));
+    writer.appendDouble(optFuncValue, false);
+    writer.append(",");
+    writer.appendDouble(optGradNorm, false);
+    writer.append(",%u,%u,%u,", numIterations, numFuncEvaluations, numGradEvaluations);
+    // Empty if the solver does not count them, as opposed to zero accepted steps.
+    if (hasInitialSteps)
+    {
+        writer.append("%u", numAcceptedInitialSteps);
+    }
+    for (Eigen::VectorXd::Index i = 0; i < optParameters.size(); ++i)
+    {
+        writer.append(",");
+        writer.appendDouble(optParameters(i), false);
+    }
+
+    return writer.finish();
+}
+
+std::size_t Result::writeCsvHeader(char *                 buffer,
+                                   std::size_t            capacity,
+                                   Eigen::VectorXd::Index numParameters)
+{
+    TextWriter writer(buffer, capacity);
+
+    writer.append("exitFlag,optFuncValue,optGradNorm,numIterations,numFuncEvaluations,numGradEvaluations,numAcceptedInitialSteps");
+    for (Eigen::VectorXd::Index i = 0; i < numParameters; ++i)
+    {
+        writer.append(",optParameter%ld", static_cast<long>(i));
+    }
+
+    return writer.finish();
+}
+
+std::size_t Result::writeBinary(char * buffer, std::size_t capacity) const
+{
+    const std::size_t size = getBinarySize();
+    if (size > capacity)
+    {
+        return 0;
+    }
+
+    BinaryHeader header;
+    header.exitFlag                = static_cast<std::uint32_t>(exitFlag);
+    header.numIterations           = numIterations;
+    header.numFuncEvaluations      = numFuncEvaluations;
+    header.numGradEvaluations      = numGradEvaluations;
+    header.numAcceptedInitialSteps = numAcceptedInitialSteps;
+    header.hasInitialSteps         = hasInitialSteps ? 1 : 0;
+    header.optFuncValue            = optFuncValue;
+    header.optGradNorm             = optGradNorm;
+    header.numParameters           = static_cast<std::uint64_t>(optParameters.size());
+
+    std::memcpy(buffer, &header, sizeof(BinaryHeader));
+    if (optParameters.size() > 0)
+    {
+        std::memcpy(buffer + sizeof(BinaryHeader), optParameters.data(), optParameters.size() * sizeof(double));
+    }
+
+    return size;
+}
+
 std::ostream & operator<<(std::ostream & out, 
                           const Result & result)
 {
@@ -25,6 +218,10 @@ std::ostream & operator<<(std::ostream & out,
     {
         out << "Line search failed\n";
     } 
+    else if (result.exitFlag == TrustRegionFailed) 
+    {
+        out << "Trust region failed\n";
+    } 
     else 
     {
         out << "Unknown exit flag\n";
@@ -34,7 +231,18 @@ std::ostream & operator<<(std::ostream & out,
     out << "               Number of iterations          : " << result.numIterations << std::endl;
     out << "               Number of function evaluations: " << result.numFuncEvaluations << std::endl;
     out << "               Number of gradient evaluations: " << result.numGradEvaluations << std::endl;
+    if (result.hasInitialSteps)
+    {
+        out << "               Initial step acceptance rate  : " << result.getInitialStepAcceptanceRate() << std::endl;
+    }
     out << "               Function value                : " << result.optFuncValue << std::endl;
+    for (std::size_t i = 0; i < result.lineSearchDecisions.size(); i++)
+    {
+        const LineSearchDecision & decision = result.lineSearchDecisions[i];
+        out << ((i == 0) ? "               Line search decisions         : " : "                                               ");
+        out << decision.lineSearch << " from iteration " << decision.iteration
+            << " (function cost " << decision.funcCost << " s, gradient cost " << decision.gradCost << " s)" << std::endl;
+    }
     out << "               Optimal parameters            : ";
     int n = result.optParameters.size();
     for (int i = 0; i < n; i++)
@@ -0,0 +1,10 @@
+#include <Optimization/SR1.hpp>
+
+
+namespace Optimization
+{
+
+template class SR1Policy<Eigen::Dynamic>;
+template class SR1<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <Optimization/SparseNewton.hpp>
+
+
+namespace Optimization
+{
+
+template class SparseNewtonPolicy<Function<Eigen::Dynamic>>;
+template class SparseNewton<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/SpectralProjectedGradient.hpp>
+
+
+namespace Optimization
+{
+
+template class SpectralProjectedGradient<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/StochasticAlgorithm.hpp>
+
+
+namespace Optimization
+{
+
+template class StochasticAlgorithm<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/StochasticFunction.hpp>
+
+
+namespace Optimization
+{
+
+template class StochasticFunction<Eigen::Dynamic>;
+
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include <Optimization/StochasticGradientDescent.hpp>
+
+
+namespace Optimization
+{
+
+template class StochasticGradientDescent<Eigen::Dynamic>;
+
+}
\ No newline at end of file
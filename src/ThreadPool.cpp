@@ -0,0 +1,125 @@
+#include <Optimization/ThreadPool.hpp>
+
+
+namespace Optimization
+{
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+:
+task(nullptr),
+numTasks(0),
+nextTask(0),
+numFinishedTasks(0),
+numBusyWorkers(0),
+generation(0),
+stop(false)
+{
+    // hardware_concurrency may return zero when it is not computable.
+    for (unsigned int i = 1; i < numThreads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread & worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(unsigned int numTasks,
+                     Task         task)
+{
+    if (numTasks == 0)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Workers woken late for a previous loop must leave it before it is replaced.
+        finished.wait(lock, [this] { return numBusyWorkers == 0; });
+
+        this->task       = &task;
+        this->numTasks   = numTasks;
+        nextTask         = 0;
+        numFinishedTasks = 0;
+        ++generation;
+    }
+    wakeUp.notify_all();
+
+    execute();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return numFinishedTasks == this->numTasks && numBusyWorkers == 0; });
+    this->task = nullptr;
+}
+
+unsigned int ThreadPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void ThreadPool::work()
+{
+    unsigned int lastGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return stop || generation != lastGeneration; });
+
+            if (stop)
+            {
+                return;
+            }
+
+            lastGeneration = generation;
+            ++numBusyWorkers;
+        }
+
+        execute();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --numBusyWorkers;
+        }
+        finished.notify_all();
+    }
+}
+
+void ThreadPool::execute()
+{
+    while (true)
+    {
+        const unsigned int index = nextTask.fetch_add(1);
+        if (index >= numTasks)
+        {
+            return;
+        }
+
+        (*task)(index);
+
+        bool allFinished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            allFinished = (++numFinishedTasks == numTasks);
+        }
+        if (allFinished)
+        {
+            finished.notify_all();
+        }
+    }
+}
+
+}
@@ -0,0 +1,9 @@
+#include <Optimization/TrustRegionSubproblem.hpp>
+
+
+namespace Optimization
+{
+
+template class TrustRegionSubproblem<Eigen::Dynamic>;
+
+}
\ No newline at end of file
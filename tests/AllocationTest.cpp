@@ -0,0 +1,124 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <Optimization/BFGS.hpp>
+#include <Optimization/ConjugateGradient.hpp>
+#include <Optimization/LBFGS.hpp>
+#include <Optimization/LineSearchBackTrack.hpp>
+#include <Optimization/LineSearchParallel.hpp>
+#include <Optimization/SteepestDescent.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  Checks that repeated solves of the same dimension do not allocate. Eigen allocations are
+ *  trapped by EIGEN_RUNTIME_NO_MALLOC, and all others are counted by the replaced global
+ *  operator new. The first solve of every solver sizes its workspace and is not counted.
+ */
+
+
+static unsigned long numAllocations = 0;
+
+void * operator new(std::size_t size)
+{
+    ++numAllocations;
+    if (void * pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void objFunc(const Eigen::VectorXd & parameters, double & funcValue)
+{
+    funcValue = 100 * std::pow(parameters(1) - std::pow(parameters(0), 2), 2) + std::pow(1 - parameters(0), 2);
+
+    return;
+}
+
+void gradFunc(const Eigen::VectorXd & parameters, Eigen::VectorXd & gradient)
+{
+    gradient(0) = -400 * (parameters(1) - std::pow(parameters(0), 2.0)) * parameters(0) - 2 * (1 - parameters(0));
+    gradient(1) = 200 * (parameters(1) - std::pow(parameters(0), 2.0));
+
+    return;
+}
+
+int main()
+{
+    const int numSolves = 10;
+
+    Function<> objFuncInfoExactDerivative(objFunc, gradFunc);
+    Function<> objFuncInfoApproxDerivative(objFunc);
+    Eigen::VectorXd initialParameters(2);
+    initialParameters << -5, 10;
+    Result result;
+
+    BFGS<> bfgsExact(objFuncInfoExactDerivative, initialParameters);
+    BFGS<> bfgsApprox(objFuncInfoApproxDerivative, initialParameters);
+    SteepestDescent<> steepestDescent(objFuncInfoExactDerivative, initialParameters);
+    SteepestDescent<> steepestDescentBackTrack(objFuncInfoExactDerivative, initialParameters, 1e-9, 1e-9, 100000,
+                                               std::make_shared<LineSearchBackTrack<>>(objFuncInfoExactDerivative));
+    ConjugateGradient<> conjugateGradient(objFuncInfoExactDerivative, initialParameters);
+    LBFGS<> lbfgs(objFuncInfoExactDerivative, initialParameters);
+    BFGS<> bfgsParallel(objFuncInfoExactDerivative, initialParameters, 1e-9, 1e-9, 100000,
+                        std::make_shared<LineSearchParallel<>>(objFuncInfoExactDerivative, std::make_shared<ThreadPool>(2)));
+
+    // Warm-up, sizes the workspaces.
+    bfgsExact.solve(result);
+    bfgsApprox.solve(result);
+    steepestDescent.solve(result);
+    steepestDescentBackTrack.solve(result);
+    conjugateGradient.solve(result);
+    lbfgs.solve(result);
+    bfgsParallel.solve(result);
+
+    const unsigned long numWarmUpAllocations = numAllocations;
+    Eigen::internal::set_is_malloc_allowed(false);
+
+    for (int i = 0; i < numSolves; ++i)
+    {
+        bfgsExact.solve(result);
+        bfgsApprox.solve(result);
+        steepestDescent.solve(result);
+        steepestDescentBackTrack.solve(result);
+        conjugateGradient.solve(result);
+        lbfgs.solve(result);
+        bfgsParallel.solve(result);
+    }
+
+    Eigen::internal::set_is_malloc_allowed(true);
+    const unsigned long numSolveAllocations = numAllocations - numWarmUpAllocations;
+
+    std::cout << "Allocations in " << numSolves << " repeated solves: " << numSolveAllocations << std::endl;
+
+    return (numSolveAllocations == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
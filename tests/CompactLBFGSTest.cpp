@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <Optimization/CompactLBFGS.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  Compares the products and the reduced solve of CompactLBFGS with a dense BFGS matrix built
+ *  from the same pairs, i.e. the BFGS updates of theta I with the stored pairs, oldest first.
+ *  More pairs are added than the memory holds, hence the comparison covers the ring buffer
+ *  after it wrapped around.
+ */
+
+
+const int n = 8;
+const unsigned int memory = 3;
+const int numPairs = 8;
+const double tol = 1e-10;
+
+Eigen::MatrixXd denseHessian(const std::vector<Eigen::VectorXd> & s,
+                             const std::vector<Eigen::VectorXd> & y)
+{
+    const std::size_t last = s.size() - 1;
+    const std::size_t first = (s.size() > memory) ? s.size() - memory : 0;
+
+    Eigen::MatrixXd hessian = y[last].squaredNorm() / s[last].dot(y[last]) * Eigen::MatrixXd::Identity(n, n);
+    for (std::size_t i = first; i <= last; i++)
+    {
+        const Eigen::VectorXd hessianS = hessian * s[i];
+        hessian += y[i] * y[i].transpose() / y[i].dot(s[i]) - hessianS * hessianS.transpose() / s[i].dot(hessianS);
+    }
+
+    return hessian;
+}
+
+bool check(const char * name, const Eigen::VectorXd & actual, const Eigen::VectorXd & expected, int numUpdates)
+{
+    const double error = (actual - expected).norm() / expected.norm();
+    if (error > tol)
+    {
+        std::cout << name << " after " << numUpdates << " pairs: relative error " << error << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main()
+{
+    // Pairs of a quadratic with a symmetric positive definite Hessian, hence none is skipped.
+    const Eigen::MatrixXd random = Eigen::MatrixXd::Random(n, n);
+    const Eigen::MatrixXd curvature = random * random.transpose() + n * Eigen::MatrixXd::Identity(n, n);
+
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(n);
+    const std::vector<Eigen::Index> indices = {0, 2, 3, 5, 7};
+    const Eigen::VectorXd rhs = Eigen::VectorXd::Random(indices.size());
+
+    CompactLBFGS<> matrix(memory);
+    matrix.reset(n);
+
+    std::vector<Eigen::VectorXd> s;
+    std::vector<Eigen::VectorXd> y;
+    bool success = true;
+
+    for (int k = 1; k <= numPairs; k++)
+    {
+        s.push_back(Eigen::VectorXd::Random(n));
+        y.push_back(curvature * s.back());
+        if (!matrix.update(s.back(), y.back()))
+        {
+            std::cout << "Pair " << k << " was skipped" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const Eigen::MatrixXd hessian = denseHessian(s, y);
+        Eigen::VectorXd result;
+
+        // B v
+        matrix.applyHessian(v, result);
+        success = check("B v", result, hessian * v, k) && success;
+
+        // H v
+        matrix.applyInverseHessian(v, result);
+        success = check("H v", result, hessian.ldlt().solve(v), k) && success;
+
+        // (Z^T B Z)^-1 rhs
+        Eigen::MatrixXd reducedHessian(indices.size(), indices.size());
+        for (std::size_t i = 0; i < indices.size(); i++)
+        {
+            for (std::size_t j = 0; j < indices.size(); j++)
+            {
+                reducedHessian(i, j) = hessian(indices[i], indices[j]);
+            }
+        }
+
+        Eigen::VectorXd reducedResult;
+        matrix.solveReduced(indices, rhs, reducedResult);
+        success = check("Reduced solve", reducedResult, reducedHessian.ldlt().solve(rhs), k) && success;
+    }
+
+    std::cout << "Compact L-BFGS matrix " << (success ? "matches" : "does not match") << " the dense BFGS matrix" << std::endl;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,216 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Optimization/Result.hpp>
+
+
+using namespace Optimization;
+
+
+/*
+ *  Reads back the records of the serializers of Result and compares them with the result they
+ *  were written from, with and without counted initial steps. Every capacity smaller than a
+ *  record has to be rejected.
+ */
+
+
+const std::size_t capacity = 4096;
+
+bool success = true;
+
+void check(bool condition, const std::string & message)
+{
+    if (!condition)
+    {
+        std::cout << message << std::endl;
+        success = false;
+    }
+}
+
+// Equality, which also holds between two NaNs.
+bool same(double a, double b)
+{
+    return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+std::vector<std::string> splitCsv(const std::string & record)
+{
+    std::vector<std::string> fields(1);
+    for (char c : record)
+    {
+        if (c == ',')
+        {
+            fields.emplace_back();
+        }
+        else if (c != '\n')
+        {
+            fields.back() += c;
+        }
+    }
+
+    return fields;
+}
+
+// The text after "key": in a JSON record, up to the next comma or closing bracket.
+std::string jsonValue(const std::string & record, const std::string & key)
+{
+    const std::size_t begin = record.find("\"" + key + "\":");
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+
+    const std::size_t valueBegin = begin + key.size() + 3;
+    const std::size_t valueEnd = record.find_first_of(",]}", valueBegin);
+
+    return record.substr(valueBegin, valueEnd - valueBegin);
+}
+
+void checkBinary(const Result & result, const std::string & name)
+{
+    std::vector<char> buffer(capacity);
+    const std::size_t size = result.writeBinary(buffer.data(), buffer.size());
+    check(size == result.getBinarySize(), name + ": binary size");
+
+    Result::BinaryHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    check(header.exitFlag == static_cast<std::uint32_t>(result.getExitFlag()), name + ": binary exit flag");
+    check(header.numIterations == result.getNumIterations(), name + ": binary iterations");
+    check(header.numFuncEvaluations == result.getNumFuncEvaluations(), name + ": binary function evaluations");
+    check(header.numGradEvaluations == result.getNumGradEvaluations(), name + ": binary gradient evaluations");
+    check(header.numAcceptedInitialSteps == result.getNumAcceptedInitialSteps(), name + ": binary accepted initial steps");
+    check(header.hasInitialSteps == (result.hasInitialStepStatistics() ? 1u : 0u), name + ": binary initial step flag");
+    check(same(header.optFuncValue, result.getOptFuncValue()), name + ": binary function value");
+    check(header.optGradNorm == result.getOptGradNorm(), name + ": binary gradient norm");
+    check(header.numParameters == static_cast<std::uint64_t>(result.getOptParameters().size()), name + ": binary number of parameters");
+
+    Eigen::VectorXd parameters(header.numParameters);
+    std::memcpy(parameters.data(), buffer.data() + sizeof(header), parameters.size() * sizeof(double));
+    check(parameters == result.getOptParameters(), name + ": binary parameters");
+
+    // Too small buffers are rejected and left untouched.
+    for (std::size_t tooSmall = 0; tooSmall < size; tooSmall++)
+    {
+        std::vector<char> small(tooSmall + 1, 'x');
+        check(result.writeBinary(small.data(), tooSmall) == 0, name + ": binary overflow");
+        check(small == std::vector<char>(tooSmall + 1, 'x'), name + ": binary buffer changed on overflow");
+    }
+}
+
+void checkCsv(const Result & result, const std::string & name)
+{
+    std::vector<char> buffer(capacity);
+    const std::size_t size = result.writeCsv(buffer.data(), buffer.size());
+    check(size > 0 && buffer[size - 1] == '\n', name + ": CSV record ends with a newline");
+
+    const std::vector<std::string> fields = splitCsv(std::string(buffer.data(), size));
+    const Eigen::Index numParameters = result.getOptParameters().size();
+
+    const std::size_t headerSize = Result::writeCsvHeader(buffer.data(), buffer.size(), numParameters);
+    check(splitCsv(std::string(buffer.data(), headerSize)).size() == fields.size(), name + ": CSV header and record widths");
+
+    check(fields.size() == 7 + static_cast<std::size_t>(numParameters), name + ": CSV number of fields");
+    if (fields.size() != 7 + static_cast<std::size_t>(numParameters))
+    {
+        return;
+    }
+    check(fields[0] == exitFlagName(result.getExitFlag()), name + ": CSV exit flag");
+    check(same(std::strtod(fields[1].c_str(), nullptr), result.getOptFuncValue()), name + ": CSV function value");
+    check(std::strtod(fields[2].c_str(), nullptr) == result.getOptGradNorm(), name + ": CSV gradient norm");
+    check(std::stoul(fields[3]) == result.getNumIterations(), name + ": CSV iterations");
+    check(std::stoul(fields[4]) == result.getNumFuncEvaluations(), name + ": CSV function evaluations");
+    check(std::stoul(fields[5]) == result.getNumGradEvaluations(), name + ": CSV gradient evaluations");
+    if (result.hasInitialStepStatistics())
+    {
+        check(!fields[6].empty() && std::stoul(fields[6]) == result.getNumAcceptedInitialSteps(), name + ": CSV accepted initial steps");
+    }
+    else
+    {
+        check(fields[6].empty(), name + ": CSV untracked initial steps are empty");
+    }
+    for (Eigen::Index i = 0; i < numParameters; i++)
+    {
+        check(std::strtod(fields[7 + i].c_str(), nullptr) == result.getOptParameters()(i), name + ": CSV parameter");
+    }
+
+    for (std::size_t tooSmall = 0; tooSmall < size; tooSmall++)
+    {
+        check(result.writeCsv(buffer.data(), tooSmall) == 0, name + ": CSV overflow");
+    }
+}
+
+void checkJson(const Result & result, const std::string & name)
+{
+    std::vector<char> buffer(capacity);
+    const std::size_t size = result.writeJson(buffer.data(), buffer.size());
+    check(size > 0 && buffer[size - 1] == '\n', name + ": JSON record ends with a newline");
+
+    const std::string record(buffer.data(), size);
+    check(jsonValue(record, "exitFlag") == "\"" + std::string(exitFlagName(result.getExitFlag())) + "\"", name + ": JSON exit flag");
+    if (std::isfinite(result.getOptFuncValue()))
+    {
+        check(std::strtod(jsonValue(record, "optFuncValue").c_str(), nullptr) == result.getOptFuncValue(), name + ": JSON function value");
+    }
+    else
+    {
+        check(jsonValue(record, "optFuncValue") == "null", name + ": JSON non-finite function value is null");
+    }
+    check(std::strtod(jsonValue(record, "optGradNorm").c_str(), nullptr) == result.getOptGradNorm(), name + ": JSON gradient norm");
+    check(std::stoul(jsonValue(record, "numIterations")) == result.getNumIterations(), name + ": JSON iterations");
+    check(std::stoul(jsonValue(record, "numFuncEvaluations")) == result.getNumFuncEvaluations(), name + ": JSON function evaluations");
+    check(std::stoul(jsonValue(record, "numGradEvaluations")) == result.getNumGradEvaluations(), name + ": JSON gradient evaluations");
+    if (result.hasInitialStepStatistics())
+    {
+        check(jsonValue(record, "numAcceptedInitialSteps") == std::to_string(result.getNumAcceptedInitialSteps()), name + ": JSON accepted initial steps");
+    }
+    else
+    {
+        check(jsonValue(record, "numAcceptedInitialSteps") == "null", name + ": JSON untracked initial steps are null");
+    }
+
+    const std::size_t begin = record.find("\"optParameters\":[") + 17;
+    const char * position = record.c_str() + begin;
+    for (Eigen::Index i = 0; i < result.getOptParameters().size(); i++)
+    {
+        char * end;
+        check(std::strtod(position, &end) == result.getOptParameters()(i), name + ": JSON parameter");
+        position = end + 1;
+    }
+
+    for (std::size_t tooSmall = 0; tooSmall < size; tooSmall++)
+    {
+        check(result.writeJson(buffer.data(), tooSmall) == 0, name + ": JSON overflow");
+    }
+}
+
+int main()
+{
+    Eigen::VectorXd parameters(5);
+    parameters << 0.1, -1.0 / 3.0, 1e-300, -2.5e17, 0.0;
+
+    Result tracked;
+    tracked.set(Relative, parameters, 1.0 / 7.0, 3.0e-9, 42, 117, 58, 37);
+
+    Result untracked;
+    untracked.set(LineSearchFailed, parameters, std::nan(""), 0.5, 7, 9, 0);
+
+    const Result defaultConstructed;
+
+    const Result * results[] = {&tracked, &untracked, &defaultConstructed};
+    for (const Result * result : results)
+    {
+        const std::string name = (result == &tracked) ? "Tracked" : (result == &untracked) ? "Untracked" : "Default";
+
+        checkBinary(*result, name);
+        checkCsv(*result, name);
+        checkJson(*result, name);
+    }
+
+    std::cout << "Result records " << (success ? "match" : "do not match") << " the results" << std::endl;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}